@@ -0,0 +1,116 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+/**
+ * @file bench.h
+ * @brief Helpers of the benchmark programs: reproducible random numbers, Zipfian ranks, timing,
+ * option lists and option values.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @struct zipf_s
+ * @brief Generator of Zipfian ranks in [0, n), where rank 0 is the most frequent one.
+ *
+ * The generator of Gray et al. ("Quickly generating billion-record synthetic databases"), as used by
+ * YCSB. The number of ranks can grow without recomputing the zeta constant from scratch.
+ */
+typedef struct zipf {
+  uint64_t n;      /**< Number of ranks */
+  double theta;    /**< Skew, in (0, 1) */
+  double zetan;    /**< Sum of 1 / i^theta for i in [1, n] */
+  double zeta2;    /**< Sum of 1 / i^theta for i in [1, 2] */
+  double alpha;    /**< 1 / (1 - theta) */
+  double eta;      /**< Scale of the ranks beyond 1 */
+} zipf_s;
+
+/**
+ * @brief Seeds the random numbers of the calling process.
+ * @param seed The seed; the same seed always gives the same numbers.
+ */
+void bench_seed(uint64_t seed);
+
+/**
+ * @brief Draws a pseudo-random number (xorshift64*).
+ * @return The number.
+ */
+uint64_t bench_random(void);
+
+/**
+ * @brief Draws a pseudo-random number in [0, 1).
+ * @return The number.
+ */
+double bench_uniform(void);
+
+/**
+ * @brief Spreads a rank over the non-negative integers, so that consecutive ranks are not neighbours.
+ * @param rank The rank.
+ * @return The key of the rank.
+ */
+int bench_scramble(uint64_t rank);
+
+/**
+ * @brief Returns the time of a monotonic clock.
+ * @return The time in nanoseconds.
+ */
+double bench_now_ns(void);
+
+/**
+ * @brief Checks whether a name is in a comma separated list.
+ * @param list The list, or NULL for all names.
+ * @param name The name.
+ * @return true if the name is in the list.
+ */
+bool bench_in_list(const char *list, const char *name);
+
+/**
+ * @brief Parses the value of an integer option, e.g. the N of --records=N.
+ * @param value The value, a whole decimal integer.
+ * @param min The lowest value accepted.
+ * @param max The highest value accepted.
+ * @param result Receives the integer.
+ * @return false if the value is not a whole decimal integer in [min, max], e.g. "1e6" or "".
+ */
+bool bench_parse_long(const char *value, long min, long max, long *result);
+
+/**
+ * @brief Parses the value of a seed option.
+ * @param value The value, a whole decimal integer in the range of uint64_t, without sign.
+ * @param result Receives the seed.
+ * @return false if the value is not such an integer.
+ */
+bool bench_parse_seed(const char *value, uint64_t *result);
+
+/**
+ * @brief Parses the value of a real option, e.g. the F of --hot=F.
+ * @param value The value, a whole decimal number.
+ * @param result Receives the number.
+ * @return false if the value is not a whole decimal number.
+ */
+bool bench_parse_double(const char *value, double *result);
+
+/**
+ * @brief Initializes a generator of Zipfian ranks.
+ * @param zipf The generator.
+ * @param n The number of ranks, at least 1.
+ * @param theta The skew, in (0, 1); YCSB uses 0.99.
+ */
+void zipf_init(zipf_s *zipf, uint64_t n, double theta);
+
+/**
+ * @brief Increases the number of ranks of a generator, in time proportional to the new ranks.
+ * @param zipf The generator.
+ * @param n The new number of ranks, not lower than the current one.
+ */
+void zipf_grow(zipf_s *zipf, uint64_t n);
+
+/**
+ * @brief Draws a Zipfian rank.
+ * @param zipf The generator.
+ * @return The rank, in [0, n).
+ */
+uint64_t zipf_next(zipf_s *zipf);
+
+#endif /* BENCH_H */
@@ -12,6 +12,129 @@
  */
 typedef struct binary_tree binary_tree_s;
 
+/**
+ * @struct bst_ops_t
+ * @brief Operations of an engine, i.e. of an implementation of the binary search tree.
+ *
+ * Each engine defines its own binary_tree_s and exports its operations in a bst_ops_t named
+ * <name>_bst_ops. The functions of this header dispatch to the engine selected with bst_use().
+ */
+typedef struct bst_ops {
+  const char *name;                                            /**< The name of the engine */
+  binary_tree_s *(*add_node)(int value, binary_tree_s *tree);  /**< See add_node() */
+  bool (*find_node)(int value, binary_tree_s *tree);           /**< See find_node() */
+  binary_tree_s *(*remove_node)(int value, binary_tree_s *tree); /**< See remove_node() */
+  int (*binary_tree_height)(binary_tree_s *tree);              /**< See binary_tree_height() */
+  int (*binary_tree_nodes)(binary_tree_s *tree);               /**< See binary_tree_nodes() */
+  int (*min_value_node)(binary_tree_s *node);                  /**< See min_value_node() */
+  void (*dump_tree)(binary_tree_s *tree, bool ascending);      /**< See dump_tree() */
+  int (*binary_tree_to_array)(binary_tree_s *tree, int *array); /**< See binary_tree_to_array() */
+  void (*binary_tree_print)(binary_tree_s *tree);              /**< See binary_tree_print() */
+  void (*binary_tree_free)(binary_tree_s *tree);               /**< See binary_tree_free() */
+  bool stats;                                                  /**< Whether it maintains bst_stats */
+} bst_ops_t;
+
+extern const bst_ops_t simple_bst_ops;     /**< Simple (unbalanced) binary search tree */
+extern const bst_ops_t avl_bst_ops;        /**< AVL tree */
+extern const bst_ops_t rb_bst_ops;         /**< Red-black tree */
+extern const bst_ops_t treap_bst_ops;      /**< Treap */
+extern const bst_ops_t scapegoat_bst_ops;  /**< Scapegoat tree */
+extern const bst_ops_t wavl_bst_ops;       /**< Weak AVL tree */
+extern const bst_ops_t skiplist_bst_ops;   /**< Skip list */
+extern const bst_ops_t radix_bst_ops;      /**< Adaptive radix tree */
+extern const bst_ops_t adaptive_bst_ops;   /**< Sorted array promoted to an AVL tree */
+extern const bst_ops_t bucket_bst_ops;     /**< AVL tree with sorted leaf buckets */
+extern const bst_ops_t roaring_bst_ops;    /**< Roaring bitmap */
+
+/**
+ * @brief Lists the available engines.
+ *
+ * @return The engines, in a NULL terminated array.
+ */
+const bst_ops_t *const *bst_engines(void);
+
+/**
+ * @brief Finds an engine by its name.
+ *
+ * @param name The name of the engine, e.g. "avl" or "rb".
+ * @return The engine, or NULL if there is no engine with this name.
+ */
+const bst_ops_t *bst_engine(const char *name);
+
+/**
+ * @brief Selects the engine used by the functions of this header.
+ *
+ * The engine must not be changed while trees built by the previous engine are still in use.
+ * The default engine is the simple binary search tree.
+ *
+ * @param ops The engine.
+ */
+void bst_use(const bst_ops_t *ops);
+
+/**
+ * @brief Returns the engine used by the functions of this header.
+ *
+ * @return The current engine.
+ */
+const bst_ops_t *bst_current(void);
+
+/**
+ * @brief The engine used by the functions of this header.
+ *
+ * Only read directly by the inline find_node(); use bst_current() and bst_use() instead.
+ */
+extern const bst_ops_t *bst_current_ops;
+
+/**
+ * @struct bst_stats_t
+ * @brief Counters of the work done by the operations of the engines.
+ *
+ * The counters are only maintained when the engines are compiled with BST_STATS defined (see the
+ * stats profile of the Makefile); otherwise the counting macros expand to nothing and the counters
+ * stay at zero. They are maintained by the engines whose bst_ops_t has stats set, i.e. all of them but
+ * radix and roaring, which have no comparison-based search path to count.
+ */
+typedef struct bst_stats {
+  unsigned long comparisons;  /**< Comparisons of the searched value with the value of a node */
+  unsigned long visits;       /**< Nodes visited by the operations */
+  unsigned long rotations;    /**< Left and right rotations; for the treap, nodes relinked by a split or a merge */
+  unsigned long recolorings;  /**< Changes of the color of a node of a red-black tree */
+  unsigned long rebuilt;      /**< Nodes relinked by the rebuild of a subtree of a scapegoat tree */
+  unsigned long allocations;  /**< Allocated nodes */
+} bst_stats_t;
+
+/**
+ * @brief The counters, only updated by the engines when BST_STATS is defined.
+ *
+ * Only updated directly by the engines; use bst_stats_get() and bst_stats_reset() instead.
+ */
+extern bst_stats_t bst_stats;
+
+#ifdef BST_STATS
+/** @brief Adds n to a counter of bst_stats. */
+#define BST_ADD(counter, n) ((void)(bst_stats.counter += (n)))
+#else
+#define BST_ADD(counter, n) ((void)0)
+#endif
+
+/** @brief Increments a counter of bst_stats. */
+#define BST_COUNT(counter) BST_ADD(counter, 1)
+
+/** @brief Evaluates a comparison of values, counting it. */
+#define BST_COMPARE(test) (BST_COUNT(comparisons), (test))
+
+/**
+ * @brief Returns the counters of the work done by the operations since the last reset.
+ *
+ * @return A copy of the counters, all zero unless the engines were compiled with BST_STATS.
+ */
+bst_stats_t bst_stats_get(void);
+
+/**
+ * @brief Sets all the counters to zero.
+ */
+void bst_stats_reset(void);
+
 /**
  * @brief Adds a node with a specified value to a binary tree.
  * 
@@ -26,12 +149,22 @@ binary_tree_s *add_node(int value, binary_tree_s *tree);
 
 /**
  * @brief Checks whether a node with a specified value exists within the tree.
+ *
+ * When BST_INLINE_FIND is defined before including this header, find_node() is a static inline
+ * function calling the current engine directly, so that a lookup in a hot loop costs a single
+ * indirect call instead of a call to the library and then to the engine.
  * 
  * @param value The value to find in the tree.
  * @param tree The pointer to the starting binary tree node.
  * @return Boolean.
  */
+#ifdef BST_INLINE_FIND
+static inline bool find_node(int value, binary_tree_s *tree) {
+  return bst_current_ops->find_node(value, tree);
+}
+#else
 bool find_node(int value, binary_tree_s *tree);
+#endif
 
 /**
  * @brief Removes a node with a specific value from the binary tree if it exists.
@@ -80,6 +213,15 @@ int min_value_node(binary_tree_s *node);
  */
 void dump_tree(binary_tree_s *tree, bool ascending);
 
+/**
+ * @brief Copies all values of the binary search tree in ascending order into an array.
+ *
+ * @param tree The pointer to the starting binary tree node.
+ * @param array The array receiving the values, which must hold at least binary_tree_nodes(tree) values.
+ * @return The number of values copied.
+ */
+int binary_tree_to_array(binary_tree_s *tree, int *array);
+
 /**
  * @brief Generates a text representation (ASCII art) of the binary tree.
  * 
@@ -0,0 +1,90 @@
+#ifndef EF_SET_H
+#define EF_SET_H
+
+/**
+ * @file ef_set.h
+ * @brief Immutable compressed sets of integers, encoded with the Elias-Fano representation.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "bst.h"
+
+/**
+ * @struct ef_set_s
+ * @brief Structure of the compressed set.
+ */
+typedef struct ef_set ef_set_s;
+
+/**
+ * @brief Builds a compressed set from sorted values.
+ * @param values The values, in strictly ascending order.
+ * @param n The number of values.
+ * @return A pointer to the newly created set.
+ */
+ef_set_s *ef_create(const int *values, int n);
+
+/**
+ * @brief Builds a compressed set holding the values of a binary search tree.
+ *
+ * The tree is walked in order and is left unchanged; it can be freed once the set is built.
+ * @param tree The binary search tree (can be NULL if the tree is empty).
+ * @return A pointer to the newly created set.
+ */
+ef_set_s *bst_compress(binary_tree_s *tree);
+
+/**
+ * @brief Counts the values of the set.
+ * @param set The compressed set.
+ * @return The number of values.
+ */
+int ef_size(ef_set_s *set);
+
+/**
+ * @brief Checks whether a value belongs to the set.
+ * @param value The value to find.
+ * @param set The compressed set.
+ * @return true if the value is in the set, false otherwise.
+ */
+bool ef_find(int value, ef_set_s *set);
+
+/**
+ * @brief Counts the values of the set lower than a given value.
+ * @param value The value.
+ * @param set The compressed set.
+ * @return The number of values strictly lower than value.
+ */
+int ef_rank(int value, ef_set_s *set);
+
+/**
+ * @brief Reads the value of a given rank.
+ * @param i The rank, from 0 (the minimum) to ef_size(set)-1.
+ * @param set The compressed set.
+ * @return The (i+1)-th smallest value.
+ * @note Asserts that the rank is valid.
+ */
+int ef_select(int i, ef_set_s *set);
+
+/**
+ * @brief Finds the greatest value of the set lower or equal to a given value.
+ * @param value The value.
+ * @param set The compressed set.
+ * @param floor Output : the greatest value lower or equal to value, if any.
+ * @return true if such a value exists, false otherwise.
+ */
+bool ef_floor(int value, ef_set_s *set, int *floor);
+
+/**
+ * @brief Computes the memory used by the set.
+ * @param set The compressed set.
+ * @return The size of the set in bytes.
+ */
+size_t ef_bytes(ef_set_s *set);
+
+/**
+ * @brief Erases the set.
+ * @param set The compressed set.
+ */
+void ef_free(ef_set_s *set);
+
+#endif // EF_SET_H
@@ -6,6 +6,9 @@
  * @brief Structure and functions for managing a heap data structure.
  */
 
+#include <stdbool.h>
+#include <stddef.h>
+
 /** 
  * @struct heap_s
  * @brief Structure of the heap_s.
@@ -18,15 +21,78 @@ typedef struct heap heap_s;
  */
 heap_s *heap_create();
 
+/** 
+ * @brief Creates a new heap able to hold a given number of elements without growing.
+ * @param capacity The expected number of elements (0 to allocate on the first addition).
+ * @return A pointer to the newly created empty heap.
+ */
+heap_s *heap_create_with_capacity(size_t capacity);
+
+/** 
+ * @brief Creates a heap holding the elements of an array, in O(n) (bottom-up heapify).
+ * @param array The elements.
+ * @param n The number of elements.
+ * @param take_ownership If true, the heap adopts the array without copying it: the array must have
+ * been allocated with malloc(), is freed by heap_delete() and must no longer be used by the caller.
+ * Otherwise the elements are copied and the array is left unchanged.
+ * @return A pointer to the newly created heap.
+ */
+heap_s *heap_from_array(int *array, size_t n, bool take_ownership);
+
+/** 
+ * @brief Sorts an array in ascending order with heapsort, in place.
+ *
+ * The array is heapified, then each maximum is moved after the remaining heap; no memory is
+ * allocated.
+ * @param array The elements to sort.
+ * @param n The number of elements.
+ */
+void heap_sort(int *array, size_t n);
+
+/** 
+ * @brief Reduces the capacity of the heap to its number of elements.
+ * @param heap The address of the current heap.
+ * @return The address of the updated heap.
+ * @note Asserts that the heap is already created.
+ */
+heap_s *heap_shrink_to_fit(heap_s *heap);
+
+/** 
+ * @brief Returns the number of elements of the heap.
+ * @param heap The address of the current heap.
+ * @return The number of elements.
+ * @note Asserts that the heap is already created.
+ */
+size_t heap_size(heap_s *heap);
+
+/** 
+ * @brief Returns the number of elements the heap can hold without growing.
+ * @param heap The address of the current heap.
+ * @return The capacity.
+ * @note Asserts that the heap is already created.
+ */
+size_t heap_capacity(heap_s *heap);
+
 /** 
  * @brief Adds a given value to the heap.
  * @param value A new value to add.
  * @param heap The address of the current heap.
  * @return The address of the updated heap.
- * @note Asserts that the heap is already created and has enough space.
+ * @note Asserts that the heap is already created. The heap grows as needed, its capacity doubling
+ * when it is full.
  */
 heap_s *heap_add(int value, heap_s *heap);
 
+/** 
+ * @brief Returns the number of children of each node of the heap.
+ *
+ * heap.c is compiled with HEAP_ARITY children per node (2 by default); the 4-ary and 8-ary heaps
+ * implement the same functions with shallower trees. The pairing heap of pairing_heap.c, whose nodes
+ * have any number of children, returns 0.
+ * @return The arity of the heap, or 0 for the pairing heap.
+ */
+int heap_arity(void);
+
 /** 
  * @brief Tests if the heap is empty.
  * @param heap The address of the current heap.
@@ -51,6 +117,18 @@ int heap_peek(heap_s *heap);
  */
 heap_s *heap_remove(heap_s *heap);
 
+/** 
+ * @brief Moves all the elements of a heap into another one, and erases the emptied heap.
+ *
+ * The array heap appends the elements and then either moves each one up or heapifies the whole array,
+ * whichever costs less; the pairing heap links the two roots and joins the node pools, in O(1).
+ * @param heap The address of the heap which receives the elements.
+ * @param other The address of the heap to empty, which must no longer be used.
+ * @return The address of the updated heap.
+ * @note Asserts that both heaps are created.
+ */
+heap_s *heap_meld(heap_s *heap, heap_s *other);
+
 /** 
  * @brief Prints the heap elements from the head to the last element.
  * @param heap The address of the current heap.
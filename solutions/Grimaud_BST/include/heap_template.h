@@ -0,0 +1,172 @@
+#ifndef HEAP_TEMPLATE_H
+#define HEAP_TEMPLATE_H
+
+/**
+ * @file heap_template.h
+ * @brief Heaps of any element type and order, specialized at compile time.
+ *
+ * HEAP_DEFINE(prefix, type, higher, arity) defines static inline functions for a d-ary heap of
+ * elements of the given type stored in an array, where higher(a, b) is a macro (or expression)
+ * true when a must be above b. Each comparison is expanded inline, without any call through a
+ * function pointer, so a heap of structs costs the same as the int heap of heap.c, which is the
+ * instance HEAP_DEFINE(heap_int, int, HEAP_MAX, HEAP_ARITY).
+ *
+ * For instance, a min-heap of events ordered by date:
+ * @code
+ * typedef struct { double date; int id; } event_s;
+ * #define EVENT_BEFORE(a, b) ((a).date < (b).date)
+ * HEAP_DEFINE(events, event_s, EVENT_BEFORE, 4)
+ *
+ * events_s queue;
+ * events_init(&queue);
+ * events_push(&queue, (event_s){ 1.5, 7 });
+ * event_s next = events_pop(&queue);
+ * events_free(&queue);
+ * @endcode
+ *
+ * The functions on arrays are prefix_sift_up(), prefix_sift_down(), prefix_heapify(),
+ * prefix_remove_top() and prefix_sort(); the growable heap prefix_s is handled by prefix_init(),
+ * prefix_size(), prefix_push(), prefix_top(), prefix_pop() and prefix_free().
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+
+/**
+ * @brief Order of a max-heap: the largest element is at the top.
+ */
+#define HEAP_MAX(a, b) ((a) > (b))
+
+/**
+ * @brief Order of a min-heap: the smallest element is at the top.
+ */
+#define HEAP_MIN(a, b) ((a) < (b))
+
+/**
+ * @brief Index of the parent of the node i > 0 of a heap of the given arity.
+ */
+#define HEAP_PARENT(i, arity) (((i)-1)/(arity))
+
+/**
+ * @brief Index of the first child of the node i of a heap of the given arity.
+ */
+#define HEAP_FIRST_CHILD(i, arity) ((i)*(arity)+1)
+
+/**
+ * @brief Capacity of the array allocated by the first push to an empty heap, also used by the first
+ * addition of heap.c (without a capacity hint) and of indexed_heap.c.
+ */
+#define HEAP_INITIAL_CAPACITY 16
+
+/**
+ * @brief Defines a heap of elements of a type ordered by a macro.
+ * @param prefix The prefix of the names of the heap type and functions.
+ * @param type The type of the elements, copied by assignment.
+ * @param higher The order: higher(a, b) is true when a must be above b, e.g. HEAP_MAX or HEAP_MIN.
+ * @param arity The number of children of each node, a constant expression of at least 2.
+ */
+#define HEAP_DEFINE(prefix, type, higher, arity)                                                  \
+                                                                                                  \
+/** @brief Growable heap of type elements. */                                                    \
+typedef struct prefix {                                                                           \
+  type *array;      /**< The elements, NULL while the capacity is 0 */                           \
+  size_t size;      /**< Number of elements */                                                   \
+  size_t capacity;  /**< Number of elements the array can hold */                                \
+} prefix##_s;                                                                                     \
+                                                                                                  \
+/* Index of the highest child of a node which has at least one child. */                         \
+static inline size_t prefix##_highest_child(const type *array, size_t n, size_t first) {         \
+  size_t last = (first+(arity)<n)?first+(arity):n; /* after the last child */                    \
+  size_t highest = first;                                                                         \
+  for(size_t child=first+1; child<last; child++)                                                  \
+    if(higher(array[child], array[highest]))                                                      \
+      highest = child;                                                                            \
+  return highest;                                                                                 \
+}                                                                                                 \
+                                                                                                  \
+/* Moves a value up from the hole i, moving the lower parents down into it, and fills the hole. */ \
+static inline void prefix##_sift_up(type *array, size_t i, type value) {                         \
+  while(i>0 && higher(value, array[HEAP_PARENT(i, arity)])) {                                     \
+    array[i]=array[HEAP_PARENT(i, arity)];                                                        \
+    i=HEAP_PARENT(i, arity);                                                                      \
+  }                                                                                               \
+  array[i]=value;                                                                                 \
+}                                                                                                 \
+                                                                                                  \
+/* Moves the element i down, moving the higher children up into its hole. */                     \
+static inline void prefix##_sift_down(type *array, size_t n, size_t i) {                         \
+  type value=array[i];                                                                            \
+  while(HEAP_FIRST_CHILD(i, arity)<n) {                                                           \
+    size_t highest=prefix##_highest_child(array, n, HEAP_FIRST_CHILD(i, arity));                  \
+    if(!higher(array[highest], value))                                                            \
+      break;                                                                                      \
+    array[i]=array[highest];                                                                      \
+    i=highest;                                                                                    \
+  }                                                                                               \
+  array[i]=value;                                                                                 \
+}                                                                                                 \
+                                                                                                  \
+/* Rearranges n elements into a heap bottom-up (Floyd), in O(n). */                              \
+static inline void prefix##_heapify(type *array, size_t n) {                                     \
+  for(size_t i=(n>1)?HEAP_PARENT(n-1, arity)+1:0; i-->0;)                                         \
+    prefix##_sift_down(array, n, i);                                                              \
+}                                                                                                 \
+                                                                                                  \
+/* Removes the top of a heap of n > 0 elements, which then holds the first n-1 ones, and returns  \
+   it. Bottom-up deletion (Wegener): the hole goes down along the highest children to a leaf, then \
+   the last element, which almost always belongs near the leaves, moves up from there. */        \
+static inline type prefix##_remove_top(type *array, size_t n) {                                  \
+  type top=array[0];                                                                              \
+  n--;                                                                                            \
+  size_t i=0;                                                                                     \
+  while(HEAP_FIRST_CHILD(i, arity)<n) {                                                           \
+    size_t highest=prefix##_highest_child(array, n, HEAP_FIRST_CHILD(i, arity));                  \
+    array[i]=array[highest];                                                                      \
+    i=highest;                                                                                    \
+  }                                                                                               \
+  prefix##_sift_up(array, i, array[n]);                                                           \
+  return top;                                                                                     \
+}                                                                                                 \
+                                                                                                  \
+/* Heapsort in place: the top goes last, so a max-heap sorts in ascending order. */              \
+static inline void prefix##_sort(type *array, size_t n) {                                        \
+  prefix##_heapify(array, n);                                                                     \
+  for(size_t k=n; k>1; k--)                                                                       \
+    array[k-1]=prefix##_remove_top(array, k);                                                     \
+}                                                                                                 \
+                                                                                                  \
+static inline void prefix##_init(prefix##_s *heap) {                                             \
+  heap->array=NULL;                                                                               \
+  heap->size=0;                                                                                   \
+  heap->capacity=0;                                                                               \
+}                                                                                                 \
+                                                                                                  \
+static inline size_t prefix##_size(const prefix##_s *heap) {                                     \
+  return heap->size;                                                                              \
+}                                                                                                 \
+                                                                                                  \
+static inline void prefix##_push(prefix##_s *heap, type value) {                                 \
+  if(heap->size==heap->capacity) {                                                                \
+    heap->capacity=(heap->capacity==0)?HEAP_INITIAL_CAPACITY:2*heap->capacity;                    \
+    heap->array=realloc(heap->array, heap->capacity*sizeof(type));                                \
+    assert(heap->array!=NULL);                                                                    \
+  }                                                                                               \
+  prefix##_sift_up(heap->array, heap->size++, value);                                             \
+}                                                                                                 \
+                                                                                                  \
+static inline type prefix##_top(const prefix##_s *heap) {                                        \
+  assert(heap->size>0);                                                                           \
+  return heap->array[0];                                                                          \
+}                                                                                                 \
+                                                                                                  \
+static inline type prefix##_pop(prefix##_s *heap) {                                              \
+  assert(heap->size>0);                                                                           \
+  return prefix##_remove_top(heap->array, heap->size--);                                          \
+}                                                                                                 \
+                                                                                                  \
+static inline void prefix##_free(prefix##_s *heap) {                                             \
+  free(heap->array);                                                                              \
+  prefix##_init(heap);                                                                            \
+}
+
+#endif // HEAP_TEMPLATE_H
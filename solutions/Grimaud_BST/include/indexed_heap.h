@@ -0,0 +1,139 @@
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+/**
+ * @file indexed_heap.h
+ * @brief Min-heap whose elements are reached through handles, to change their keys or erase them.
+ *
+ * Adding a key returns a handle which stays valid until the element leaves the heap; the heap keeps
+ * the position of each handle up to date, so that decreasing or increasing a key (shortest paths,
+ * rescheduled timers) and erasing an element (cancelled timers) cost O(log n), instead of adding a
+ * duplicate and skipping the stale copies when they reach the top. The handles of removed elements
+ * are reused by the following additions.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @struct indexed_heap_s
+ * @brief Structure of the indexed heap.
+ */
+typedef struct indexed_heap indexed_heap_s;
+
+/**
+ * @brief Handle of an element of an indexed heap, an index in [0, the largest size of the heap).
+ */
+typedef size_t heap_handle_t;
+
+/**
+ * @brief Creates a new empty indexed heap.
+ * @return A pointer to the newly created heap.
+ */
+indexed_heap_s *indexed_heap_create(void);
+
+/**
+ * @brief Returns the number of elements of the heap.
+ * @param heap The address of the current heap.
+ * @return The number of elements.
+ */
+size_t indexed_heap_size(indexed_heap_s *heap);
+
+/**
+ * @brief Tests if the heap is empty.
+ * @param heap The address of the current heap.
+ * @return true if the heap is empty, false otherwise.
+ */
+bool indexed_heap_empty(indexed_heap_s *heap);
+
+/**
+ * @brief Adds a key to the heap.
+ * @param heap The address of the current heap.
+ * @param key The key.
+ * @return The handle of the new element.
+ */
+heap_handle_t indexed_heap_add(indexed_heap_s *heap, int key);
+
+/**
+ * @brief Tests if a handle designates an element of the heap.
+ * @param heap The address of the current heap.
+ * @param handle The handle.
+ * @return true if the element of the handle is in the heap.
+ */
+bool indexed_heap_contains(indexed_heap_s *heap, heap_handle_t handle);
+
+/**
+ * @brief Returns the key of an element.
+ * @param heap The address of the current heap.
+ * @param handle The handle of the element.
+ * @return The key.
+ * @note Asserts that the element is in the heap.
+ */
+int indexed_heap_key(indexed_heap_s *heap, heap_handle_t handle);
+
+/**
+ * @brief Returns the smallest key.
+ * @param heap The address of the current heap.
+ * @return The key at the top of the heap.
+ * @note Asserts that the heap is not empty.
+ */
+int indexed_heap_peek(indexed_heap_s *heap);
+
+/**
+ * @brief Returns the handle of the element with the smallest key.
+ * @param heap The address of the current heap.
+ * @return The handle of the top of the heap.
+ * @note Asserts that the heap is not empty.
+ */
+heap_handle_t indexed_heap_peek_handle(indexed_heap_s *heap);
+
+/**
+ * @brief Removes the element with the smallest key.
+ * @param heap The address of the current heap.
+ * @return The handle of the removed element, which is no longer valid.
+ * @note Asserts that the heap is not empty.
+ */
+heap_handle_t indexed_heap_remove(indexed_heap_s *heap);
+
+/**
+ * @brief Lowers the key of an element, which moves up.
+ * @param heap The address of the current heap.
+ * @param handle The handle of the element.
+ * @param key The new key, not greater than the current one.
+ * @note Asserts that the element is in the heap.
+ */
+void indexed_heap_decrease_key(indexed_heap_s *heap, heap_handle_t handle, int key);
+
+/**
+ * @brief Raises the key of an element, which moves down.
+ * @param heap The address of the current heap.
+ * @param handle The handle of the element.
+ * @param key The new key, not lower than the current one.
+ * @note Asserts that the element is in the heap.
+ */
+void indexed_heap_increase_key(indexed_heap_s *heap, heap_handle_t handle, int key);
+
+/**
+ * @brief Changes the key of an element, in either direction.
+ * @param heap The address of the current heap.
+ * @param handle The handle of the element.
+ * @param key The new key.
+ * @note Asserts that the element is in the heap.
+ */
+void indexed_heap_update(indexed_heap_s *heap, heap_handle_t handle, int key);
+
+/**
+ * @brief Removes any element of the heap.
+ * @param heap The address of the current heap.
+ * @param handle The handle of the element, which is no longer valid afterwards.
+ * @note Asserts that the element is in the heap.
+ */
+void indexed_heap_erase(indexed_heap_s *heap, heap_handle_t handle);
+
+/**
+ * @brief Erases the heap.
+ * @param heap The address of the current heap.
+ */
+void indexed_heap_delete(indexed_heap_s *heap);
+
+#endif // INDEXED_HEAP_H
@@ -0,0 +1,80 @@
+#ifndef RADIX_HEAP_H
+#define RADIX_HEAP_H
+
+/**
+ * @file radix_heap.h
+ * @brief Monotone min-heap of unsigned integer keys (radix heap).
+ *
+ * The functions follow heap.h, for a min-heap of 64-bit unsigned keys (32-bit keys convert without
+ * loss). The heap is monotone: a key added must not be lower than the last key removed or peeked, as
+ * with the times of the events of a simulation. The keys are kept in buckets by the highest bit where
+ * they differ from the last key removed, so that an addition costs O(1) and a removal O(log C)
+ * amortized, C being the largest difference between a key and the last key removed, without
+ * comparing keys along a tree.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @struct radix_heap_s
+ * @brief Structure of the radix heap.
+ */
+typedef struct radix_heap radix_heap_s;
+
+/**
+ * @brief Creates a new empty radix heap, whose last removed key is 0.
+ * @return A pointer to the newly created heap.
+ */
+radix_heap_s *radix_heap_create(void);
+
+/**
+ * @brief Returns the number of keys of the heap.
+ * @param heap The address of the current heap.
+ * @return The number of keys.
+ */
+size_t radix_heap_size(radix_heap_s *heap);
+
+/**
+ * @brief Tests if the heap is empty.
+ * @param heap The address of the current heap.
+ * @return true if the heap is empty, false otherwise.
+ */
+bool radix_heap_empty(radix_heap_s *heap);
+
+/**
+ * @brief Adds a key to the heap.
+ * @param key The key, not lower than the last key removed or peeked.
+ * @param heap The address of the current heap.
+ * @return The address of the updated heap.
+ * @note Asserts that the key is not lower than the last key removed or peeked.
+ */
+radix_heap_s *radix_heap_add(uint64_t key, radix_heap_s *heap);
+
+/**
+ * @brief Returns the smallest key without removing it.
+ *
+ * Finding it may move keys between buckets, which is part of the cost of the next removal; the keys
+ * added afterwards must not be lower than this one.
+ * @param heap The address of the current heap.
+ * @return The smallest key.
+ * @note Asserts that the heap is not empty.
+ */
+uint64_t radix_heap_peek(radix_heap_s *heap);
+
+/**
+ * @brief Removes the smallest key.
+ * @param heap The address of the current heap.
+ * @return The address of the updated heap.
+ * @note Asserts that the heap is not empty.
+ */
+radix_heap_s *radix_heap_remove(radix_heap_s *heap);
+
+/**
+ * @brief Erases the heap.
+ * @param heap The address of the current heap.
+ */
+void radix_heap_delete(radix_heap_s *heap);
+
+#endif // RADIX_HEAP_H
@@ -0,0 +1,71 @@
+#ifndef TOPK_H
+#define TOPK_H
+
+/**
+ * @file topk.h
+ * @brief Streaming selection of the k largest (or smallest) values of a stream of int.
+ *
+ * A top-k keeps the k best values pushed so far in a heap whose top is the worst of them, the
+ * threshold: a value which is not better than the threshold is rejected by a single comparison, and a
+ * better one replaces the top. The memory is O(k) whatever the length of the stream, and a stream of
+ * n values costs O(n + k log k log(n/k)) on average when its values come in random order.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @struct topk_t
+ * @brief Structure of the top-k.
+ */
+typedef struct topk topk_t;
+
+/**
+ * @brief Creates a new empty top-k.
+ * @param k The number of values to keep.
+ * @param largest true to keep the k largest values, false to keep the k smallest ones.
+ * @return A pointer to the newly created top-k.
+ */
+topk_t *topk_create(size_t k, bool largest);
+
+/**
+ * @brief Returns the number of values kept, the lower of k and the number of values pushed.
+ * @param topk The address of the current top-k.
+ * @return The number of values.
+ */
+size_t topk_size(topk_t *topk);
+
+/**
+ * @brief Pushes a value of the stream.
+ * @param topk The address of the current top-k.
+ * @param value The value, kept if fewer than k values are kept or if it is better than the worst.
+ */
+void topk_push(topk_t *topk, int value);
+
+/**
+ * @brief Pushes consecutive values of the stream.
+ *
+ * Same as topk_push() on each value, but the values are compared with the threshold a block at a
+ * time, in a loop the compiler vectorizes, and the blocks without any better value are skipped.
+ * @param topk The address of the current top-k.
+ * @param values The values.
+ * @param n The number of values.
+ */
+void topk_push_batch(topk_t *topk, const int *values, size_t n);
+
+/**
+ * @brief Copies the values kept, best first: in descending order for the k largest values, in
+ * ascending order for the k smallest ones.
+ * @param topk The address of the current top-k, which is left unchanged.
+ * @param result Receives the values, room for topk_size() of them.
+ * @return The number of values, topk_size().
+ */
+size_t topk_result(topk_t *topk, int *result);
+
+/**
+ * @brief Erases the top-k.
+ * @param topk The address of the current top-k.
+ */
+void topk_delete(topk_t *topk);
+
+#endif // TOPK_H
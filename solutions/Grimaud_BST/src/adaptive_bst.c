@@ -0,0 +1,297 @@
+/**
+ * @file adaptive_bst.c
+ * @brief Implementation of the binary search tree operations in C with an adaptive representation.
+ *
+ * This file contains an implementation of the ordered set operations of bst.h which stores small sets
+ * in a sorted array embedded in the set itself : a search is a branchless binary search, an insertion
+ * or a removal moves the following values with memmove, and no allocation is made once the set exists.
+ * When the set grows beyond SMALL_MAX values, it is promoted to an AVL tree (the avl_bst.c engine), and
+ * when the AVL tree shrinks down to SMALL_MIN values, the set is demoted back to the sorted array. The AVL
+ * tree is only used through the operations of its engine, avl_bst_ops, and the private entry points of
+ * avl_bst_internal.h which build it from the sorted array and tell whether an update changed it.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include "bst.h"
+#include "avl_bst_internal.h"
+
+/**
+ * @brief Maximal number of values kept in the sorted array before the promotion to an AVL tree.
+ */
+#define SMALL_MAX 64
+
+/**
+ * @brief Number of values under which an AVL tree is demoted to the sorted array.
+ */
+#define SMALL_MIN 32
+
+/**
+ * @struct binary_tree_s
+ * @brief A structure to represent an adaptive set.
+ *
+ * The set is either small, its values being in the sorted array, or large, its values being in the
+ * AVL tree. An empty set is represented by NULL.
+ */
+typedef struct binary_tree {
+  int size;                          /**< The number of values in the set */
+  void *large;                       /**< The AVL tree (avl_bst_ops) holding the values, NULL while small */
+  int values[SMALL_MAX];             /**< The values in ascending order, while the set is small */
+} binary_tree_s;
+
+/**
+ * @brief Finds the position of the first value which is not lower than a given value.
+ *
+ * The loop always halves the remaining range and uses a conditional move instead of a branch,
+ * so its number of steps only depends on the size of the array.
+ *
+ * @param values The sorted values.
+ * @param n The number of values.
+ * @param value The value searched.
+ * @return The position of the first value greater or equal to value, n if there is none.
+ */
+static int lower_bound(const int *values, int n, int value) {
+  if (n == 0)
+    return 0;
+  const int *base = values;
+  while (n > 1) {
+    BST_COUNT(comparisons);
+    int half = n / 2;
+    base = (base[half] < value) ? base + half : base;
+    n -= half;
+  }
+  BST_COUNT(comparisons);
+  return (base - values) + (*base < value);
+}
+
+/**
+ * @brief Calculates the height of the set, 0 while it is a sorted array.
+ *
+ * @param tree The set.
+ * @return The height of the AVL tree, 0 for a small set, -1 for an empty set.
+ */
+static int adaptive_binary_tree_height(binary_tree_s *tree) {
+  if (tree == NULL)
+    return -1;
+  if (tree->large != NULL)
+    return avl_bst_ops.binary_tree_height(tree->large);
+  return 0;
+}
+
+/**
+ * @brief Counts the number of values in the set.
+ *
+ * @param tree The set.
+ * @return The number of values. Returns 0 if the set is empty.
+ */
+static int adaptive_binary_tree_nodes(binary_tree_s *tree) {
+  if (tree == NULL)
+    return 0;
+  return tree->size;
+}
+
+/**
+ * @brief Prints the set, as an array while it is small and as an AVL tree otherwise.
+ *
+ * @param tree The set to be printed.
+ */
+static void adaptive_binary_tree_print(binary_tree_s *tree) {
+  if (tree != NULL && tree->large != NULL) {
+    avl_bst_ops.binary_tree_print(tree->large);
+    return;
+  }
+  int height = adaptive_binary_tree_height(tree);
+  int nodes = adaptive_binary_tree_nodes(tree);
+  printf("height : %d  - nodes : %d\n", height, nodes);
+  if (height < 0) {
+    printf("Empty binary tree.\n");
+    return;
+  }
+  printf("[");
+  for (int i = 0; i < tree->size; i++)
+    printf("(%04d)", tree->values[i]);
+  printf("]\n");
+  return;
+}
+
+/**
+ * @brief Find the minimum value in the set.
+ *
+ * @param tree The set, which must not be empty.
+ * @return the minimum value.
+ */
+static int adaptive_min_value_node(binary_tree_s *tree) {
+  assert(tree != NULL);
+  if (tree->large != NULL)
+    return avl_bst_ops.min_value_node(tree->large);
+  return tree->values[0];
+}
+
+/**
+ * @brief Adds a value to the set.
+ *
+ * A small set inserts the value in its array. When the array is full, a balanced AVL tree is built
+ * from the values and the new one in linear time, without any rotation. If the value already exists in the set, the set is returned
+ * unchanged.
+ *
+ * @param value The value to be added.
+ * @param tree The set (can be NULL if the set is empty).
+ * @return The modified set.
+ */
+static binary_tree_s *adaptive_add_node(int value, binary_tree_s *tree) {
+  if (tree == NULL) {
+    tree = malloc(sizeof(binary_tree_s));
+    assert(tree != NULL);
+    BST_COUNT(allocations);
+    tree->size = 0;
+    tree->large = NULL;
+  }
+  if (tree->large != NULL) {
+    bool added;
+    tree->large = avl_bst_add(value, tree->large, &added);
+    tree->size += added;
+    return tree;
+  }
+  int pos = lower_bound(tree->values, tree->size, value);
+  if (pos < tree->size && tree->values[pos] == value)
+    return tree;
+  if (tree->size == SMALL_MAX) {
+    // Promotion: move the array and the new value to an AVL tree
+    int values[SMALL_MAX + 1];
+    memcpy(values, tree->values, pos * sizeof(int));
+    values[pos] = value;
+    memcpy(values + pos + 1, tree->values + pos, (SMALL_MAX - pos) * sizeof(int));
+    tree->large = avl_bst_from_sorted(values, SMALL_MAX + 1);
+    tree->size++;
+    return tree;
+  }
+  memmove(tree->values + pos + 1, tree->values + pos, (tree->size - pos) * sizeof(int));
+  tree->values[pos] = value;
+  tree->size++;
+  return tree;
+}
+
+/**
+ * @brief Checks whether a value exists in the set.
+ *
+ * @param value The value to search for.
+ * @param tree The set.
+ * @return true if the value is found, false otherwise.
+ */
+static bool adaptive_find_node(int value, binary_tree_s *tree) {
+  if (tree == NULL)
+    return false;
+  if (tree->large != NULL)
+    return avl_bst_ops.find_node(value, tree->large);
+  int pos = lower_bound(tree->values, tree->size, value);
+  return pos < tree->size && tree->values[pos] == value;
+}
+
+/**
+ * @brief Prints all values of the set in a sorted order.
+ *
+ * @param tree The set to be dumped.
+ * @param ascending Specifies the order of the output: true for ascending, false for descending.
+ */
+static void adaptive_dump_tree(binary_tree_s *tree, bool ascending) {
+  if (tree == NULL)
+    return;
+  if (tree->large != NULL) {
+    avl_bst_ops.dump_tree(tree->large, ascending);
+    return;
+  }
+  for (int i = 0; i < tree->size; i++)
+    printf("%d ", tree->values[ascending ? i : tree->size - 1 - i]);
+  return;
+}
+
+/**
+ * @brief Copies all values of the set in ascending order into an array.
+ *
+ * @param tree The set.
+ * @param array The array receiving the values, large enough for all the values of the set.
+ * @return The number of values copied.
+ */
+static int adaptive_binary_tree_to_array(binary_tree_s *tree, int *array) {
+  if (tree == NULL)
+    return 0;
+  if (tree->large != NULL)
+    return avl_bst_ops.binary_tree_to_array(tree->large, array);
+  memcpy(array, tree->values, tree->size * sizeof(int));
+  return tree->size;
+}
+
+/**
+ * @brief Removes a value from the set if it exists.
+ *
+ * When a large set goes down to SMALL_MIN values, its AVL tree is copied back to the array and freed.
+ *
+ * @param value The value to be removed.
+ * @param tree The set.
+ * @return The modified set; NULL if the set is empty after removal.
+ */
+static binary_tree_s *adaptive_remove_node(int value, binary_tree_s *tree) {
+  if (tree == NULL)
+    return NULL;
+  if (tree->large != NULL) {
+    bool removed;
+    tree->large = avl_bst_remove(value, tree->large, &removed);
+    tree->size -= removed;
+    if (tree->size <= SMALL_MIN) {
+      // Demotion: copy the AVL tree back to the array
+      avl_bst_ops.binary_tree_to_array(tree->large, tree->values);
+      avl_bst_ops.binary_tree_free(tree->large);
+      tree->large = NULL;
+    }
+    return tree;
+  }
+  int pos = lower_bound(tree->values, tree->size, value);
+  if (pos == tree->size || tree->values[pos] != value)
+    return tree; // Value not found
+  tree->size--;
+  memmove(tree->values + pos, tree->values + pos + 1, (tree->size - pos) * sizeof(int));
+  if (tree->size == 0) {
+    free(tree);
+    return NULL;
+  }
+  return tree;
+}
+
+/**
+ * @brief Frees the memory occupied by the set.
+ *
+ * It safely handles sets that are NULL by terminating early.
+ *
+ * @param tree Pointer to the set to be freed.
+ */
+static void adaptive_binary_tree_free(binary_tree_s *tree) {
+  if (tree == NULL)
+    return;
+  avl_bst_ops.binary_tree_free(tree->large);
+  free(tree);
+}
+
+/**
+ * @brief Operations of the adaptive set engine.
+ */
+const bst_ops_t adaptive_bst_ops = {
+  .name = "adaptive",
+  .add_node = adaptive_add_node,
+  .find_node = adaptive_find_node,
+  .remove_node = adaptive_remove_node,
+  .binary_tree_height = adaptive_binary_tree_height,
+  .binary_tree_nodes = adaptive_binary_tree_nodes,
+  .min_value_node = adaptive_min_value_node,
+  .dump_tree = adaptive_dump_tree,
+  .binary_tree_to_array = adaptive_binary_tree_to_array,
+  .binary_tree_print = adaptive_binary_tree_print,
+  .binary_tree_free = adaptive_binary_tree_free,
+  .stats = true,
+};
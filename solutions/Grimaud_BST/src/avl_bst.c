@@ -17,6 +17,7 @@
 #include <string.h>
 #include <assert.h>
 #include "bst.h"
+#include "avl_bst_internal.h"
 
 /** 
  * @struct binary_tree_s
@@ -40,7 +41,7 @@ typedef struct binary_tree {
  * @param b The second integer to compare.
  * @return The greater of the two integers, a or b.
  */
-int max(int a, int b) {
+static int max(int a, int b) {
   return (a>b)?a:b;
 }
 
@@ -53,7 +54,7 @@ int max(int a, int b) {
  * @param tree The root of the binary tree.
  * @return The height of the tree. Returns -1 if the tree is empty.
  */
-int binary_tree_height(binary_tree_s *tree) {
+static int avl_binary_tree_height(binary_tree_s *tree) {
   if(tree==NULL)
     return -1;
   else 
@@ -68,11 +69,11 @@ int binary_tree_height(binary_tree_s *tree) {
  * @param tree The root of the binary tree.
  * @return The total number of nodes in the tree. Returns 0 if the tree is empty.
  */
-int binary_tree_nodes(binary_tree_s *tree) {
+static int avl_binary_tree_nodes(binary_tree_s *tree) {
   if(tree==NULL)
     return 0;
   else 
-    return binary_tree_nodes(tree->left) + binary_tree_nodes(tree->right) + 1;
+    return avl_binary_tree_nodes(tree->left) + avl_binary_tree_nodes(tree->right) + 1;
 }
 
 /**
@@ -87,7 +88,7 @@ int binary_tree_nodes(binary_tree_s *tree) {
  * @param is_left Flag indicating if the current node is a left child.
  * @param prefix The current prefix for aligning the printed output.
  */
-void binary_tree_print_aux(binary_tree_s *node, int depth, int height, int is_left, char *prefix) {
+static void binary_tree_print_aux(binary_tree_s *node, int depth, int height, int is_left, char *prefix) {
   char new_prefix[200]; // Buffer limited to 200 bytes (<200 characters)
   if (node == NULL) return;
   // print right
@@ -122,12 +123,12 @@ void binary_tree_print_aux(binary_tree_s *node, int depth, int height, int is_le
  * 
  * @param tree The root of the binary tree to be printed.
  */
-void binary_tree_print(binary_tree_s *tree) {
-  int height = binary_tree_height(tree);
-  int nodes = binary_tree_nodes(tree);
+static void avl_binary_tree_print(binary_tree_s *tree) {
+  int height = avl_binary_tree_height(tree);
+  int nodes = avl_binary_tree_nodes(tree);
   printf("height : %d  - nodes : %d\n", height, nodes);
-  if (binary_tree_height(tree)>=0) 
-    binary_tree_print_aux(tree, 0, binary_tree_height(tree), 0, "");
+  if (avl_binary_tree_height(tree)>=0) 
+    binary_tree_print_aux(tree, 0, avl_binary_tree_height(tree), 0, "");
   else
     printf("Empty binary tree.\n");
   return;
@@ -142,62 +143,18 @@ void binary_tree_print(binary_tree_s *tree) {
  * @param node The root node of the subtree.
  * @return Node with the minimum value in the given subtree.
  */
-int min_value_node(binary_tree_s *node) {
+static int avl_min_value_node(binary_tree_s *node) {
     assert(node!=NULL);
+    BST_COUNT(visits);
     if(node->left!=NULL)
-      return min_value_node(node->left);
+      return avl_min_value_node(node->left);
     return node->value;
 }
 
-/**
- * @brief Performs a left rotation on the binary tree at the root.
- * 
- * This rotation is performed by making the right child of the root the new root of the subtree,
- * and making the original root the left child of the new root. The original right child's left
- * subtree becomes the right subtree of the new left child (original root).
- * 
- * @param tree The root of the binary tree to rotate.
- * @return The new root of the subtree after rotation.
- */
-binary_tree_s *bst_rotate_left(binary_tree_s *tree) {
-  if (tree == NULL || tree->right == NULL) {
-    return tree;  // No rotation needed if tree is NULL or has no right child
-  }
-  int l = binary_tree_height(tree->left);
-  int rl = binary_tree_height(tree->right->left);
-  int rr = binary_tree_height(tree->right->right);
-  binary_tree_s *new_root = tree->right;
-  tree->right = tree->right->left;
-  new_root->left = tree;
-  tree->height = 1 + max(l,rl);
-  new_root->height = 1 + max(tree->height,rr);
-  return new_root ;
-}
-
-/**
- * @brief Performs a right rotation on the binary tree at the root.
- * 
- * This rotation is performed by making the left child of the root the new root of the subtree,
- * and making the original root the right child of the new root. The original left child's right
- * subtree becomes the left subtree of the new right child (original root).
- * 
- * @param tree The root of the binary tree to rotate.
- * @return The new root of the subtree after rotation.
+/*
+ * The left and right rotations, shared with the inner nodes of the bucket engine.
  */
-binary_tree_s *bst_rotate_right(binary_tree_s *tree) {
-  if (tree == NULL || tree->left == NULL) {
-    return tree;  // No rotation needed if tree is NULL or has no left child
-  }
-  int r = binary_tree_height(tree->right);
-  int ll = binary_tree_height(tree->left->left);
-  int lr = binary_tree_height(tree->left->right);
-  binary_tree_s *new_root = tree->left;
-  tree->left = tree->left->right;
-  new_root->right = tree;
-  tree->height = 1+max(lr,r);
-  new_root->height = 1+max(ll,tree->height);
-  return new_root;
-}
+AVL_DEFINE_ROTATIONS(avl_binary_tree_height, AVL_ANY_NODE)
 
 /**
  * @brief Searches for a node with a specific value in the binary tree.
@@ -209,14 +166,15 @@ binary_tree_s *bst_rotate_right(binary_tree_s *tree) {
  * @param tree The root of the binary tree.
  * @return true if the value is found, false otherwise.
  */
-bool find_node(int value, binary_tree_s *tree) {
+static bool avl_find_node(int value, binary_tree_s *tree) {
   if(tree==NULL)
     return false;
-  if(tree->value==value)
+  BST_COUNT(visits);
+  if(BST_COMPARE(tree->value==value))
     return true;
-  if(tree->value < value) 
-    return find_node(value, tree->right);
-  return find_node(value, tree->left);
+  if(BST_COMPARE(tree->value < value))
+    return avl_find_node(value, tree->right);
+  return avl_find_node(value, tree->left);
 }
 
 /**
@@ -230,26 +188,68 @@ bool find_node(int value, binary_tree_s *tree) {
  * @param tree The root node of the binary tree to be dumped.
  * @param ascending Specifies the order of the output: true for ascending, false for descending.
  */
-void dump_tree(binary_tree_s *tree, bool ascending) {
+static void avl_dump_tree(binary_tree_s *tree, bool ascending) {
   if(tree != NULL){
     if(ascending){
       // Ascending to boolean
       if (tree->left != NULL)
-	dump_tree(tree->left,ascending);
+	avl_dump_tree(tree->left,ascending);
       printf("%d ",tree->value);
       if (tree->right != NULL)
-	dump_tree(tree->right,ascending);
+	avl_dump_tree(tree->right,ascending);
     } else {
       if (tree->right != NULL)
-	dump_tree(tree->right,ascending);
+	avl_dump_tree(tree->right,ascending);
       printf("%d ",tree->value);     
       if (tree->left != NULL)
-	dump_tree(tree->left,ascending);
+	avl_dump_tree(tree->left,ascending);
     }
   }
   return;
 }   
 
+/**
+ * @brief Copies all values of the binary search tree in ascending order into an array.
+ *
+ * @param tree The root node of the binary tree.
+ * @param array The array receiving the values, large enough for all the values of the tree.
+ * @return The number of values copied.
+ */
+static int avl_binary_tree_to_array(binary_tree_s *tree, int *array) {
+  if(tree==NULL)
+    return 0;
+  int n = avl_binary_tree_to_array(tree->left, array);
+  array[n++] = tree->value;
+  return n + avl_binary_tree_to_array(tree->right, array + n);
+}
+
+/**
+ * @brief Builds a balanced AVL tree from sorted values.
+ *
+ * The middle value becomes the root and both halves are built recursively, so that each node is
+ * allocated once, without any comparison nor rotation, and its height is set from its children.
+ *
+ * @param values The values, in strictly ascending order.
+ * @param n The number of values.
+ * @return The root of the tree; NULL if n is 0.
+ */
+binary_tree_s *avl_bst_from_sorted(const int *values, int n) {
+  if (n <= 0)
+    return NULL;
+  binary_tree_s *tree = malloc(sizeof(binary_tree_s));
+  if (tree == NULL) {
+    fprintf(stderr, "Memory allocation failed.\n");
+    exit(1);
+  }
+  BST_COUNT(allocations);
+  int middle = n / 2;
+  tree->value = values[middle];
+  tree->left = avl_bst_from_sorted(values, middle);
+  tree->right = avl_bst_from_sorted(values + middle + 1, n - middle - 1);
+  tree->height = 1 + max(avl_binary_tree_height(tree->left), avl_binary_tree_height(tree->right));
+  return tree;
+}
+
 /**
  * @brief Adds a node to the binary tree and balances the tree using simple rotations.
  * 
@@ -260,9 +260,10 @@ void dump_tree(binary_tree_s *tree, bool ascending) {
  *
  * @param value The value to be added to the tree.
  * @param tree The root of the binary tree (can be NULL if the tree is empty).
+ * @param added Set to whether a node was added, i.e. whether the value was not in the tree.
  * @return The new or modified root of the tree after insertion and possible rotation.
  */
-binary_tree_s *add_node(int value, binary_tree_s *tree) {
+binary_tree_s *avl_bst_add(int value, binary_tree_s *tree, bool *added) {
   // Regular BST insertion
   if (tree == NULL) {
     tree = malloc(sizeof(binary_tree_s));
@@ -270,18 +271,25 @@ binary_tree_s *add_node(int value, binary_tree_s *tree) {
       fprintf(stderr, "Memory allocation failed.\n");
       exit(1);
     }
+    BST_COUNT(allocations);
+    *added = true;
     tree->value = value;
     tree->height = 0;
     tree->left = tree->right = NULL;
-  } else if (value < tree->value) {
-    tree->left = add_node(value, tree->left);
-  } else if (value > tree->value) {
-    tree->right = add_node(value, tree->right);
+  } else {
+    BST_COUNT(visits);
+    if (BST_COMPARE(value < tree->value)) {
+      tree->left = avl_bst_add(value, tree->left, added);
+    } else if (BST_COMPARE(value > tree->value)) {
+      tree->right = avl_bst_add(value, tree->right, added);
+    } else {
+      *added = false;
+    }
   }
   // Check balance factors and rotate if necessary (height is stored in each
   // node to avoid O(n) depth computing)
-  int left_height = binary_tree_height(tree->left);
-  int right_height = binary_tree_height(tree->right);
+  int left_height = avl_binary_tree_height(tree->left);
+  int right_height = avl_binary_tree_height(tree->right);
   tree->height = 1 + ((left_height<right_height)?right_height:left_height) ;
   if (left_height - right_height > 1) {
     // Right rotation
@@ -314,18 +322,22 @@ binary_tree_s *add_node(int value, binary_tree_s *tree) {
  *
  * @param value The value of the node to be removed.
  * @param tree The root of the binary tree.
+ * @param removed Set to whether a node was removed, i.e. whether the value was in the tree.
  * @return The new or modified root of the tree after the removal and possible rebalancing.
  */
-binary_tree_s *remove_node(int value, binary_tree_s *tree) {
+binary_tree_s *avl_bst_remove(int value, binary_tree_s *tree, bool *removed) {
   if (tree == NULL) {
+    *removed = false;
     return NULL; // Value not found
   }
   // Step 1: Perform standard BST delete
-  if (value < tree->value) {
-    tree->left = remove_node(value, tree->left);
-  } else if (value > tree->value) {
-    tree->right = remove_node(value, tree->right);
+  BST_COUNT(visits);
+  if (BST_COMPARE(value < tree->value)) {
+    tree->left = avl_bst_remove(value, tree->left, removed);
+  } else if (BST_COMPARE(value > tree->value)) {
+    tree->right = avl_bst_remove(value, tree->right, removed);
   } else {
+    *removed = true;
     // Node with only one child or no child
     if (tree->left == NULL) {
       binary_tree_s *temp = tree->right;
@@ -337,11 +349,11 @@ binary_tree_s *remove_node(int value, binary_tree_s *tree) {
       tree = temp;
     } else {
       // Node with two children: Get the inorder successor
-      int temp_value = min_value_node(tree->right);
+      int temp_value = avl_min_value_node(tree->right);
       // Place the inorder successor in position of the node to be deleted
       tree->value = temp_value;
       // Delete the inorder successor
-      tree->right = remove_node(temp_value, tree->right);
+      tree->right = avl_bst_remove(temp_value, tree->right, removed);
     }
   }
   // Step 2: Rebalance the tree if the tree was modified
@@ -349,13 +361,13 @@ binary_tree_s *remove_node(int value, binary_tree_s *tree) {
     return tree; // If the tree had only one node and it was deleted
   }
   // Check balance factors and rotate if necessary
-  int left_height = binary_tree_height(tree->left);
-  int right_height = binary_tree_height(tree->right);
+  int left_height = avl_binary_tree_height(tree->left);
+  int right_height = avl_binary_tree_height(tree->right);
   tree->height = 1 + max(left_height,right_height);
   // If the tree is unbalanced, then try one of the following 4 cases
   if (left_height - right_height > 1) {
     // Left Left Case or Left Right Case
-    if (tree->left != NULL && binary_tree_height(tree->left->left) >= binary_tree_height(tree->left->right)) {
+    if (tree->left != NULL && avl_binary_tree_height(tree->left->left) >= avl_binary_tree_height(tree->left->right)) {
       return bst_rotate_right(tree);
     } else {
       tree->left = bst_rotate_left(tree->left);
@@ -363,7 +375,7 @@ binary_tree_s *remove_node(int value, binary_tree_s *tree) {
     }
   } else if (right_height - left_height > 1) {
     // Right Right Case or Right Left Case
-    if (tree->right != NULL && binary_tree_height(tree->right->right) >= binary_tree_height(tree->right->left)) {
+    if (tree->right != NULL && avl_binary_tree_height(tree->right->right) >= avl_binary_tree_height(tree->right->left)) {
       return bst_rotate_left(tree);
     } else {
       tree->right = bst_rotate_right(tree->right);
@@ -373,6 +385,30 @@ binary_tree_s *remove_node(int value, binary_tree_s *tree) {
   return tree;
 }
 
+/**
+ * @brief Adds a node to the binary tree, see avl_bst_add().
+ *
+ * @param value The value to be added to the tree.
+ * @param tree The root of the binary tree (can be NULL if the tree is empty).
+ * @return The new or modified root of the tree.
+ */
+static binary_tree_s *avl_add_node(int value, binary_tree_s *tree) {
+  bool added;
+  return avl_bst_add(value, tree, &added);
+}
+
+/**
+ * @brief Removes a node from the binary tree, see avl_bst_remove().
+ *
+ * @param value The value of the node to be removed.
+ * @param tree The root of the binary tree.
+ * @return The new or modified root of the tree; NULL if the tree is empty after removal.
+ */
+static binary_tree_s *avl_remove_node(int value, binary_tree_s *tree) {
+  bool removed;
+  return avl_bst_remove(value, tree, &removed);
+}
+
 /**
  * @brief Frees the memory occupied by a binary tree.
  *
@@ -381,13 +417,30 @@ binary_tree_s *remove_node(int value, binary_tree_s *tree) {
  *
  * @param tree Pointer to the root of the binary tree to be freed.
  */
-void binary_tree_free(binary_tree_s *tree) {
+static void avl_binary_tree_free(binary_tree_s *tree) {
   if(tree==NULL)
     return;
   if(tree->left != NULL)
-    binary_tree_free(tree->left);
+    avl_binary_tree_free(tree->left);
   if(tree->right !=NULL)
-    binary_tree_free(tree->right);
+    avl_binary_tree_free(tree->right);
   free(tree);
 }
 
+/**
+ * @brief Operations of the AVL tree engine.
+ */
+const bst_ops_t avl_bst_ops = {
+  .name = "avl",
+  .add_node = avl_add_node,
+  .find_node = avl_find_node,
+  .remove_node = avl_remove_node,
+  .binary_tree_height = avl_binary_tree_height,
+  .binary_tree_nodes = avl_binary_tree_nodes,
+  .min_value_node = avl_min_value_node,
+  .dump_tree = avl_dump_tree,
+  .binary_tree_to_array = avl_binary_tree_to_array,
+  .binary_tree_print = avl_binary_tree_print,
+  .binary_tree_free = avl_binary_tree_free,
+  .stats = true,
+};
@@ -0,0 +1,94 @@
+#ifndef _AVL_BST_INTERNAL_H_
+#define _AVL_BST_INTERNAL_H_
+
+/**
+ * @file avl_bst_internal.h
+ * @brief Parts of the AVL engine shared with the engines built on it, not part of bst.h.
+ *
+ * AVL_DEFINE_ROTATIONS() gives the rotations of avl_bst.c to the engines whose nodes have the same
+ * value, height, left and right fields, such as the inner nodes of bucket_bst.c. The other functions
+ * are entry points of the AVL engine for the adaptive engine, which promotes its sorted array to a
+ * tree of the AVL engine and keeps its size without walking the tree twice per update.
+ */
+
+#include <stdbool.h>
+#include "bst.h"
+
+/** @brief Rotation guard of AVL_DEFINE_ROTATIONS() accepting any child. */
+#define AVL_ANY_NODE(node) true
+
+/**
+ * @brief Defines bst_rotate_left() and bst_rotate_right() for the binary_tree_s of the including file.
+ *
+ * The nodes must have the left, right and height fields of the AVL nodes; the heights of both nodes
+ * are recomputed and each rotation is counted in bst_stats.
+ *
+ * @param height_of The function (or macro) giving the height of a subtree, -1 for NULL.
+ * @param can_rise The guard (a macro or an expression on a node) true when the child going up can be
+ * rotated, e.g. AVL_ANY_NODE, or a test that it is an inner node when the leaves must stay leaves.
+ */
+#define AVL_DEFINE_ROTATIONS(height_of, can_rise)                                                 \
+                                                                                                  \
+/** @brief Performs a left rotation: the right child becomes the root of the subtree. */          \
+static binary_tree_s *bst_rotate_left(binary_tree_s *tree) {                                      \
+  if (tree == NULL || tree->right == NULL || !can_rise(tree->right))                              \
+    return tree; /* No rotation possible */                                                       \
+  BST_COUNT(rotations);                                                                           \
+  int l = height_of(tree->left);                                                                  \
+  int rl = height_of(tree->right->left);                                                          \
+  int rr = height_of(tree->right->right);                                                         \
+  binary_tree_s *new_root = tree->right;                                                          \
+  tree->right = new_root->left;                                                                   \
+  new_root->left = tree;                                                                          \
+  tree->height = 1 + ((l > rl) ? l : rl);                                                         \
+  new_root->height = 1 + ((tree->height > rr) ? tree->height : rr);                               \
+  return new_root;                                                                                \
+}                                                                                                 \
+                                                                                                  \
+/** @brief Performs a right rotation: the left child becomes the root of the subtree. */          \
+static binary_tree_s *bst_rotate_right(binary_tree_s *tree) {                                     \
+  if (tree == NULL || tree->left == NULL || !can_rise(tree->left))                                \
+    return tree; /* No rotation possible */                                                       \
+  BST_COUNT(rotations);                                                                           \
+  int r = height_of(tree->right);                                                                 \
+  int ll = height_of(tree->left->left);                                                           \
+  int lr = height_of(tree->left->right);                                                          \
+  binary_tree_s *new_root = tree->left;                                                           \
+  tree->left = new_root->right;                                                                   \
+  new_root->right = tree;                                                                         \
+  tree->height = 1 + ((lr > r) ? lr : r);                                                         \
+  new_root->height = 1 + ((ll > tree->height) ? ll : tree->height);                               \
+  return new_root;                                                                                \
+}
+
+/**
+ * @brief Builds a balanced tree of the AVL engine (avl_bst_ops) from sorted values, in O(n).
+ *
+ * @param values The values, in strictly ascending order.
+ * @param n The number of values.
+ * @return The root of the tree, to be used with avl_bst_ops; NULL if n is 0.
+ */
+binary_tree_s *avl_bst_from_sorted(const int *values, int n);
+
+/**
+ * @brief Adds a value to a tree of the AVL engine, like avl_bst_ops.add_node, telling whether it was added.
+ *
+ * @param value The value to add.
+ * @param tree The root of the tree (can be NULL if the tree is empty).
+ * @param added Set to false if the value was already in the tree, true otherwise.
+ * @return The new root of the tree.
+ */
+binary_tree_s *avl_bst_add(int value, binary_tree_s *tree, bool *added);
+
+/**
+ * @brief Removes a value from a tree of the AVL engine, like avl_bst_ops.remove_node, telling whether it
+ * was removed.
+ *
+ * @param value The value to remove.
+ * @param tree The root of the tree.
+ * @param removed Set to true if the value was in the tree, false otherwise.
+ * @return The new root of the tree; NULL if the tree is empty after removal.
+ */
+binary_tree_s *avl_bst_remove(int value, binary_tree_s *tree, bool *removed);
+
+#endif /* _AVL_BST_INTERNAL_H_ */
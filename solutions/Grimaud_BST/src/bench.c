@@ -0,0 +1,126 @@
+/**
+ * @file bench.c
+ * @brief Implementation of the helpers of the benchmark programs.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <assert.h>
+#include "bench.h"
+
+/*
+ * The functions of bench.h are documented in the header.
+ */
+
+/**
+ * @brief State of the xorshift64* generator.
+ */
+static uint64_t rng_state = 1;
+
+void bench_seed(uint64_t seed) {
+  rng_state = (seed * 0x9E3779B97F4A7C15ULL) | 1; // never 0, the fixed point of xorshift
+}
+
+uint64_t bench_random(void) {
+  rng_state ^= rng_state >> 12;
+  rng_state ^= rng_state << 25;
+  rng_state ^= rng_state >> 27;
+  return rng_state * 0x2545F4914F6CDD1DULL;
+}
+
+double bench_uniform(void) {
+  return (bench_random() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+int bench_scramble(uint64_t rank) {
+  rank *= 0x9E3779B97F4A7C15ULL;
+  return (int)((rank ^ (rank >> 32)) & 0x7fffffff);
+}
+
+double bench_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+bool bench_in_list(const char *list, const char *name) {
+  if (list == NULL)
+    return true;
+  size_t length = strlen(name);
+  for (const char *item = list; item != NULL; item = strchr(item, ',')) {
+    if (*item == ',')
+      item++;
+    if (strncmp(item, name, length) == 0 && (item[length] == ',' || item[length] == '\0'))
+      return true;
+  }
+  return false;
+}
+
+bool bench_parse_long(const char *value, long min, long max, long *result) {
+  char *end;
+  errno = 0;
+  *result = strtol(value, &end, 10);
+  return end != value && *end == '\0' && errno == 0 && *result >= min && *result <= max;
+}
+
+bool bench_parse_seed(const char *value, uint64_t *result) {
+  char *end;
+  errno = 0;
+  unsigned long long seed = strtoull(value, &end, 10);
+  *result = seed;
+  // strtoull() accepts a '-' and negates the value
+  return end != value && *end == '\0' && errno == 0 && strchr(value, '-') == NULL;
+}
+
+bool bench_parse_double(const char *value, double *result) {
+  char *end;
+  errno = 0;
+  *result = strtod(value, &end);
+  return end != value && *end == '\0' && errno == 0;
+}
+
+/**
+ * @brief Updates the constants of a generator depending on its number of ranks.
+ *
+ * @param zipf The generator, whose zetan is up to date.
+ */
+static void zipf_update(zipf_s *zipf) {
+  zipf->eta = (1.0 - pow(2.0 / zipf->n, 1.0 - zipf->theta)) / (1.0 - zipf->zeta2 / zipf->zetan);
+}
+
+void zipf_init(zipf_s *zipf, uint64_t n, double theta) {
+  assert(n >= 1 && theta > 0 && theta < 1);
+  zipf->n = 0;
+  zipf->theta = theta;
+  zipf->zetan = 0;
+  zipf->zeta2 = 1.0 + 1.0 / pow(2, theta);
+  zipf->alpha = 1.0 / (1.0 - theta);
+  zipf_grow(zipf, n);
+}
+
+void zipf_grow(zipf_s *zipf, uint64_t n) {
+  assert(n >= zipf->n);
+  for (uint64_t i = zipf->n + 1; i <= n; i++)
+    zipf->zetan += 1.0 / pow(i, zipf->theta);
+  zipf->n = n;
+  zipf_update(zipf);
+}
+
+uint64_t zipf_next(zipf_s *zipf) {
+  double uz = bench_uniform() * zipf->zetan;
+  if (uz < 1.0)
+    return 0;
+  if (uz < zipf->zeta2 && zipf->n > 1)
+    return 1;
+  return (uint64_t)(zipf->n * pow(zipf->eta * bench_uniform() - zipf->eta + 1.0, zipf->alpha)) % zipf->n;
+}
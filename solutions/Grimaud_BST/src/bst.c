@@ -0,0 +1,138 @@
+/**
+ * @file bst.c
+ * @brief Dispatch of the binary search tree operations to the selected engine.
+ *
+ * Every engine (simple_bst.c, avl_bst.c, rb_bst.c...) keeps its functions static and exports them in a
+ * bst_ops_t. This file provides the functions of bst.h, which call the operations of the current engine,
+ * so that all the engines can be linked into one program and chosen at runtime.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include "bst.h"
+
+/**
+ * @brief The available engines.
+ */
+static const bst_ops_t *const engines[] = {
+  &simple_bst_ops, &avl_bst_ops, &rb_bst_ops, &treap_bst_ops, &scapegoat_bst_ops, &wavl_bst_ops,
+  &skiplist_bst_ops, &radix_bst_ops, &adaptive_bst_ops, &bucket_bst_ops, &roaring_bst_ops, NULL
+};
+
+/**
+ * @brief The engine used by the functions of bst.h.
+ */
+const bst_ops_t *bst_current_ops = &simple_bst_ops;
+
+/**
+ * @brief Lists the available engines.
+ *
+ * @return The engines, in a NULL terminated array.
+ */
+const bst_ops_t *const *bst_engines(void) {
+  return engines;
+}
+
+/**
+ * @brief Finds an engine by its name.
+ *
+ * @param name The name of the engine, e.g. "avl" or "rb".
+ * @return The engine, or NULL if there is no engine with this name.
+ */
+const bst_ops_t *bst_engine(const char *name) {
+  for (int i = 0; engines[i] != NULL; i++)
+    if (strcmp(engines[i]->name, name) == 0)
+      return engines[i];
+  return NULL;
+}
+
+/**
+ * @brief Selects the engine used by the functions of bst.h.
+ *
+ * @param ops The engine.
+ */
+void bst_use(const bst_ops_t *ops) {
+  assert(ops != NULL);
+  bst_current_ops = ops;
+}
+
+/**
+ * @brief Returns the engine used by the functions of bst.h.
+ *
+ * @return The current engine.
+ */
+const bst_ops_t *bst_current(void) {
+  return bst_current_ops;
+}
+
+/**
+ * @brief The counters of the work done by the operations, see bst_stats_t.
+ */
+bst_stats_t bst_stats;
+
+/**
+ * @brief Returns the counters of the work done by the operations since the last reset.
+ *
+ * @return A copy of the counters.
+ */
+bst_stats_t bst_stats_get(void) {
+  return bst_stats;
+}
+
+/**
+ * @brief Sets all the counters to zero.
+ */
+void bst_stats_reset(void) {
+  memset(&bst_stats, 0, sizeof(bst_stats));
+}
+
+/*
+ * The operations of bst.h, documented in the header, forward to the current engine.
+ */
+
+binary_tree_s *add_node(int value, binary_tree_s *tree) {
+  return bst_current_ops->add_node(value, tree);
+}
+
+bool find_node(int value, binary_tree_s *tree) {
+  return bst_current_ops->find_node(value, tree);
+}
+
+binary_tree_s *remove_node(int value, binary_tree_s *tree) {
+  return bst_current_ops->remove_node(value, tree);
+}
+
+int binary_tree_height(binary_tree_s *tree) {
+  return bst_current_ops->binary_tree_height(tree);
+}
+
+int binary_tree_nodes(binary_tree_s *tree) {
+  return bst_current_ops->binary_tree_nodes(tree);
+}
+
+int min_value_node(binary_tree_s *node) {
+  return bst_current_ops->min_value_node(node);
+}
+
+void dump_tree(binary_tree_s *tree, bool ascending) {
+  bst_current_ops->dump_tree(tree, ascending);
+}
+
+int binary_tree_to_array(binary_tree_s *tree, int *array) {
+  return bst_current_ops->binary_tree_to_array(tree, array);
+}
+
+void binary_tree_print(binary_tree_s *tree) {
+  bst_current_ops->binary_tree_print(tree);
+}
+
+void binary_tree_free(binary_tree_s *tree) {
+  bst_current_ops->binary_tree_free(tree);
+}
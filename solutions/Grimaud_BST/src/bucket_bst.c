@@ -0,0 +1,427 @@
+/**
+ * @file bucket_bst.c
+ * @brief Implementation of a binary search tree in C using an AVL tree with bucketed leaves.
+ *
+ * This file contains the implementation of an AVL tree whose leaves are buckets holding up to BUCKET_SIZE
+ * sorted values, instead of a single value. The inner nodes only route the searches : the values lower
+ * than the value of an inner node are in its left subtree, the others in its right subtree. A full bucket
+ * is split in two halves under a new inner node, and the inner nodes are balanced with the AVL rotations.
+ * The number of nodes is divided by an order of magnitude, and the end of each search is a linear scan of
+ * a small array that the compiler can vectorize.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include "bst.h"
+#include "avl_bst_internal.h"
+
+/**
+ * @brief Maximal number of values in a leaf bucket.
+ */
+#define BUCKET_SIZE 32
+
+/**
+ * @struct binary_tree_s
+ * @brief A structure to represent a node in an AVL tree with bucketed leaves.
+ *
+ * An inner node has two children and a routing value. A leaf has no child, a height of 0, and its
+ * values are stored sorted in the keys array, which is only allocated for the leaves.
+ */
+typedef struct binary_tree {
+  int value;                         /**< The routing value of an inner node */
+  int height;                        /**< The height of the tree, 0 for a leaf */
+  struct binary_tree *left;          /**< Pointer to the left child, NULL for a leaf */
+  struct binary_tree *right;         /**< Pointer to the right child, NULL for a leaf */
+  int count;                         /**< The number of values of a leaf */
+  int keys[];                        /**< The sorted values of a leaf */
+} binary_tree_s;
+
+/**
+ * @brief Returns the maximum of two integers.
+ *
+ * @param a The first integer to compare.
+ * @param b The second integer to compare.
+ * @return The greater of the two integers, a or b.
+ */
+static int max(int a, int b) {
+  return (a>b)?a:b;
+}
+
+/**
+ * @brief Allocates an empty leaf bucket.
+ *
+ * @return The new leaf.
+ */
+static binary_tree_s *leaf_create(void) {
+  binary_tree_s *leaf = malloc(sizeof(binary_tree_s) + BUCKET_SIZE * sizeof(int));
+  assert(leaf != NULL);
+  BST_COUNT(allocations);
+  leaf->height = 0;
+  leaf->left = leaf->right = NULL;
+  leaf->count = 0;
+  return leaf;
+}
+
+/**
+ * @brief Finds the position of the first value of a leaf which is not lower than a given value.
+ *
+ * @param leaf The leaf.
+ * @param value The value searched.
+ * @return The position of the first value greater or equal to value, leaf->count if there is none.
+ */
+static int leaf_position(binary_tree_s *leaf, int value) {
+  int pos = 0;
+  BST_COUNT(visits);
+  BST_ADD(comparisons, leaf->count);
+  for (int i = 0; i < leaf->count; i++)
+    pos += (leaf->keys[i] < value);
+  return pos;
+}
+
+/**
+ * @brief Calculates the height of the binary tree.
+ *
+ * The height is stored in each node, a leaf bucket having the height 0.
+ *
+ * @param tree The root of the binary tree.
+ * @return The height of the tree. Returns -1 if the tree is empty.
+ */
+static int bucket_binary_tree_height(binary_tree_s *tree) {
+  if(tree==NULL)
+    return -1;
+  else
+    return tree->height;
+}
+
+/**
+ * @brief Counts the total number of values in the binary tree.
+ *
+ * @param tree The root of the binary tree.
+ * @return The total number of values in the leaves of the tree. Returns 0 if the tree is empty.
+ */
+static int bucket_binary_tree_nodes(binary_tree_s *tree) {
+  if(tree==NULL)
+    return 0;
+  if(tree->height==0)
+    return tree->count;
+  return bucket_binary_tree_nodes(tree->left) + bucket_binary_tree_nodes(tree->right);
+}
+
+/**
+ * @brief Internal helper function to print the binary tree.
+ *
+ * This recursive function assists in printing the binary tree in a structured ASCII art format.
+ * An inner node is printed with its routing value and its height, a leaf with its values.
+ *
+ * @param node The current node being printed.
+ * @param depth The current depth in the tree.
+ * @param height The height of the tree.
+ * @param is_left Flag indicating if the current node is a left child.
+ * @param prefix The current prefix for aligning the printed output.
+ */
+static void binary_tree_print_aux(binary_tree_s *node, int depth, int height, int is_left, char *prefix) {
+  char new_prefix[200]; // Buffer limited to 200 bytes (<200 characters)
+  if (node == NULL) return;
+  // print right
+  if (node->right != NULL) {
+    char *s1 = (is_left) ? "│" : " ";
+    char *s2 = (is_left) ? " " : "│";
+    snprintf(new_prefix, sizeof(new_prefix), "%s%s          ", prefix, s1);
+    binary_tree_print_aux(node->right, depth + 1, height, 0, new_prefix);
+    snprintf(new_prefix, sizeof(new_prefix), "%s%s          ", prefix, s2);
+  }
+  // print node
+  printf("%s", prefix);
+  char *s1 = (depth) ? ((is_left) ? "└" : "┌") : " ";
+  if (node->height == 0) {
+    printf("%s[", s1);
+    for (int i = 0; i < node->count; i++)
+      printf((i > 0) ? " %d" : "%d", node->keys[i]);
+    printf("]\n");
+  } else {
+    printf("%s(%04d)[%02d]┤\n", s1, node->value, node->height);
+  }
+  // print left
+  if (node->left != NULL) {
+    char *s1 = (depth) ? ((is_left) ? " " : "│") : " ";
+    char *s2 = (depth) ? ((is_left) ? "│" : " ") : " ";
+    snprintf(new_prefix, sizeof(new_prefix), "%s%s          ", prefix, s1);
+    binary_tree_print_aux(node->left, depth + 1, height, 1, new_prefix);
+    snprintf(new_prefix, sizeof(new_prefix), "%s%s          ", prefix, s2);
+  }
+  return;
+}
+
+/**
+ * @brief Public function to print the entire binary tree.
+ *
+ * This function prints the binary tree starting from the root. It displays the tree's height and number of values
+ * before printing the tree structure.
+ *
+ * @param tree The root of the binary tree to be printed.
+ */
+static void bucket_binary_tree_print(binary_tree_s *tree) {
+  int height = bucket_binary_tree_height(tree);
+  int nodes = bucket_binary_tree_nodes(tree);
+  printf("height : %d  - nodes : %d\n", height, nodes);
+  if (height>=0)
+    binary_tree_print_aux(tree, 0, height, 0, "");
+  else
+    printf("Empty binary tree.\n");
+  return;
+}
+
+/**
+ * @brief Find the minimum value in a binary search tree.
+ *
+ * @param node The root node of the subtree.
+ * @return The minimum value in the given subtree, i.e. the first value of its leftmost leaf.
+ */
+static int bucket_min_value_node(binary_tree_s *node) {
+  assert(node!=NULL);
+  while(node->height>0)
+    node = node->left;
+  return node->keys[0];
+}
+
+/**
+ * @brief Rotation guard: only inner nodes go up, so that the leaf buckets stay at the bottom.
+ */
+#define IS_INNER(node) ((node)->height > 0)
+
+/*
+ * The left and right rotations of the AVL engine, on the inner nodes.
+ */
+AVL_DEFINE_ROTATIONS(bucket_binary_tree_height, IS_INNER)
+
+/**
+ * @brief Updates the height of an inner node and restores its balance with the AVL rotations.
+ *
+ * @param tree An inner node whose subtrees are balanced.
+ * @return The new root of the subtree.
+ */
+static binary_tree_s *rebalance(binary_tree_s *tree) {
+  int left_height = bucket_binary_tree_height(tree->left);
+  int right_height = bucket_binary_tree_height(tree->right);
+  tree->height = 1 + max(left_height,right_height);
+  if (left_height - right_height > 1) {
+    // Left Left Case or Left Right Case
+    if (bucket_binary_tree_height(tree->left->left) < bucket_binary_tree_height(tree->left->right))
+      tree->left = bst_rotate_left(tree->left);
+    return bst_rotate_right(tree);
+  } else if (right_height - left_height > 1) {
+    // Right Right Case or Right Left Case
+    if (bucket_binary_tree_height(tree->right->right) < bucket_binary_tree_height(tree->right->left))
+      tree->right = bst_rotate_right(tree->right);
+    return bst_rotate_left(tree);
+  }
+  return tree;
+}
+
+/**
+ * @brief Searches for a value in the binary tree.
+ *
+ * The inner nodes are followed down to a leaf, whose values are all compared without branching.
+ *
+ * @param value The value to search for in the tree.
+ * @param tree The root of the binary tree.
+ * @return true if the value is found, false otherwise.
+ */
+static bool bucket_find_node(int value, binary_tree_s *tree) {
+  if(tree==NULL)
+    return false;
+  while(tree->height>0) {
+    BST_COUNT(visits);
+    tree = BST_COMPARE(value < tree->value) ? tree->left : tree->right;
+  }
+  BST_COUNT(visits);
+  BST_ADD(comparisons, tree->count);
+  bool found = false;
+  for (int i = 0; i < tree->count; i++)
+    found |= (tree->keys[i] == value);
+  return found;
+}
+
+/**
+ * @brief Prints all values in the binary search tree in a sorted order.
+ *
+ * The values are displayed in ascending order if `ascending` is true, and in descending order if
+ * `ascending` is false.
+ *
+ * @param tree The root node of the binary tree to be dumped.
+ * @param ascending Specifies the order of the output: true for ascending, false for descending.
+ */
+static void bucket_dump_tree(binary_tree_s *tree, bool ascending) {
+  if(tree == NULL)
+    return;
+  if(tree->height == 0) {
+    for (int i = 0; i < tree->count; i++)
+      printf("%d ", tree->keys[ascending ? i : tree->count - 1 - i]);
+  } else {
+    bucket_dump_tree(ascending ? tree->left : tree->right, ascending);
+    bucket_dump_tree(ascending ? tree->right : tree->left, ascending);
+  }
+  return;
+}
+
+/**
+ * @brief Copies all values of the binary search tree in ascending order into an array.
+ *
+ * @param tree The root node of the binary tree.
+ * @param array The array receiving the values, large enough for all the values of the tree.
+ * @return The number of values copied.
+ */
+static int bucket_binary_tree_to_array(binary_tree_s *tree, int *array) {
+  if(tree==NULL)
+    return 0;
+  if(tree->height==0) {
+    memcpy(array, tree->keys, tree->count * sizeof(int));
+    return tree->count;
+  }
+  int n = bucket_binary_tree_to_array(tree->left, array);
+  return n + bucket_binary_tree_to_array(tree->right, array + n);
+}
+
+/**
+ * @brief Adds a value to the binary tree and balances the tree.
+ *
+ * The value is inserted in its leaf. A full leaf is split in two halves, which become the children
+ * of a new inner node routing on the first value of the upper half. The inner nodes are then
+ * rebalanced on the way back up to the root. If the value already exists in the tree, the tree is
+ * returned unchanged.
+ *
+ * @param value The value to be added to the tree.
+ * @param tree The root of the binary tree (can be NULL if the tree is empty).
+ * @return The new or modified root of the tree after insertion and possible rotation.
+ */
+static binary_tree_s *bucket_add_node(int value, binary_tree_s *tree) {
+  if (tree == NULL)
+    tree = leaf_create();
+  if (tree->height > 0) {
+    BST_COUNT(visits);
+    if (BST_COMPARE(value < tree->value))
+      tree->left = bucket_add_node(value, tree->left);
+    else
+      tree->right = bucket_add_node(value, tree->right);
+    return rebalance(tree);
+  }
+  int pos = leaf_position(tree, value);
+  if (pos < tree->count && tree->keys[pos] == value)
+    return tree;
+  if (tree->count < BUCKET_SIZE) {
+    memmove(&tree->keys[pos + 1], &tree->keys[pos], (tree->count - pos) * sizeof(int));
+    tree->keys[pos] = value;
+    tree->count++;
+    return tree;
+  }
+  // Split the full leaf under a new inner node, then insert in the right half
+  binary_tree_s *upper = leaf_create();
+  upper->count = BUCKET_SIZE / 2;
+  tree->count = BUCKET_SIZE - upper->count;
+  memcpy(upper->keys, &tree->keys[tree->count], upper->count * sizeof(int));
+  binary_tree_s *node = malloc(sizeof(binary_tree_s));
+  assert(node != NULL);
+  BST_COUNT(allocations);
+  node->value = upper->keys[0];
+  node->height = 1;
+  node->left = tree;
+  node->right = upper;
+  node->count = 0;
+  if (value < node->value)
+    node->left = bucket_add_node(value, tree);
+  else
+    node->right = bucket_add_node(value, upper);
+  return node;
+}
+
+/**
+ * @brief Removes a value from the binary tree and rebalances the tree.
+ *
+ * The value is removed from its leaf. An empty leaf is freed with its parent, which is replaced by
+ * the sibling subtree, and two sibling leaves holding together at most half a bucket are merged.
+ * The inner nodes are then rebalanced on the way back up to the root.
+ *
+ * @param value The value to be removed.
+ * @param tree The root of the binary tree.
+ * @return The new or modified root of the tree after the removal and possible rebalancing.
+ */
+static binary_tree_s *bucket_remove_node(int value, binary_tree_s *tree) {
+  if (tree == NULL) {
+    return NULL; // Value not found
+  }
+  if (tree->height == 0) {
+    int pos = leaf_position(tree, value);
+    if (pos == tree->count || tree->keys[pos] != value)
+      return tree; // Value not found
+    tree->count--;
+    memmove(&tree->keys[pos], &tree->keys[pos + 1], (tree->count - pos) * sizeof(int));
+    if (tree->count == 0) {
+      free(tree);
+      return NULL;
+    }
+    return tree;
+  }
+  BST_COUNT(visits);
+  if (BST_COMPARE(value < tree->value))
+    tree->left = bucket_remove_node(value, tree->left);
+  else
+    tree->right = bucket_remove_node(value, tree->right);
+  if (tree->left == NULL || tree->right == NULL) {
+    // An empty leaf was freed: the sibling replaces this node
+    binary_tree_s *child = (tree->left != NULL) ? tree->left : tree->right;
+    free(tree);
+    return child;
+  }
+  if (tree->left->height == 0 && tree->right->height == 0 &&
+      tree->left->count + tree->right->count <= BUCKET_SIZE / 2) {
+    // Merge two sparse sibling leaves
+    binary_tree_s *leaf = tree->left;
+    memcpy(&leaf->keys[leaf->count], tree->right->keys, tree->right->count * sizeof(int));
+    leaf->count += tree->right->count;
+    free(tree->right);
+    free(tree);
+    return leaf;
+  }
+  return rebalance(tree);
+}
+
+/**
+ * @brief Frees the memory occupied by a binary tree.
+ *
+ * This function recursively frees all nodes of a binary tree, starting from the leaves
+ * towards the root. It safely handles trees that are NULL by terminating early.
+ *
+ * @param tree Pointer to the root of the binary tree to be freed.
+ */
+static void bucket_binary_tree_free(binary_tree_s *tree) {
+  if(tree==NULL)
+    return;
+  bucket_binary_tree_free(tree->left);
+  bucket_binary_tree_free(tree->right);
+  free(tree);
+}
+
+/**
+ * @brief Operations of the bucketed AVL tree engine.
+ */
+const bst_ops_t bucket_bst_ops = {
+  .name = "bucket",
+  .add_node = bucket_add_node,
+  .find_node = bucket_find_node,
+  .remove_node = bucket_remove_node,
+  .binary_tree_height = bucket_binary_tree_height,
+  .binary_tree_nodes = bucket_binary_tree_nodes,
+  .min_value_node = bucket_min_value_node,
+  .dump_tree = bucket_dump_tree,
+  .binary_tree_to_array = bucket_binary_tree_to_array,
+  .binary_tree_print = bucket_binary_tree_print,
+  .binary_tree_free = bucket_binary_tree_free,
+  .stats = true,
+};
@@ -0,0 +1,294 @@
+/**
+ * @file ef_set.c
+ * @brief Implementation of immutable compressed sets of integers with the Elias-Fano representation.
+ *
+ * The n values, shifted so that the minimum is 0, lie in a universe of size U. Each value is split into
+ * its l = floor(log2(U/n)) low bits, stored verbatim in a packed array, and its high bits, stored in unary
+ * in a bit vector : the value of rank i sets the bit (high + i). The whole set takes about 2 + log2(U/n)
+ * bits per value. Sampled positions of the ones and of the zeros of the bit vector give the select
+ * operations, on which the rank, find and floor operations are built.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "ef_set.h"
+
+/**
+ * @brief Number of ones (or zeros) of the high bit vector between two samples.
+ */
+#define SAMPLE 256
+
+/**
+ * @struct ef_set
+ * @brief Structure of the compressed set.
+ */
+typedef struct ef_set {
+  int n;                             /**< The number of values */
+  int min;                           /**< The minimum value, subtracted from all the values */
+  uint32_t max_offset;               /**< The maximum value minus the minimum value */
+  int low_bits;                      /**< The number l of low bits stored per value */
+  uint64_t *low;                     /**< The packed low bits, l bits per value */
+  uint64_t *high;                    /**< The high bit vector, in unary */
+  uint64_t high_size;                /**< The number of bits of the high bit vector */
+  uint64_t *ones;                    /**< Position of the ones of rank 0, SAMPLE, 2*SAMPLE... */
+  uint64_t *zeros;                   /**< Position of the zeros of rank 0, SAMPLE, 2*SAMPLE... */
+} ef_set_s;
+
+/**
+ * @brief Reads the low bits of the value of a given rank.
+ */
+static uint32_t get_low(ef_set_s *set, int i) {
+  if (set->low_bits == 0)
+    return 0;
+  uint64_t pos = (uint64_t)i * set->low_bits;
+  uint64_t word = pos / 64, shift = pos % 64;
+  uint64_t bits = set->low[word] >> shift;
+  if (shift + set->low_bits > 64)
+    bits |= set->low[word + 1] << (64 - shift);
+  return bits & ((1ull << set->low_bits) - 1);
+}
+
+/**
+ * @brief Writes the low bits of the value of a given rank, the array being initially zeroed.
+ */
+static void set_low(ef_set_s *set, int i, uint32_t bits) {
+  if (set->low_bits == 0)
+    return;
+  uint64_t pos = (uint64_t)i * set->low_bits;
+  uint64_t word = pos / 64, shift = pos % 64;
+  set->low[word] |= (uint64_t)bits << shift;
+  if (shift + set->low_bits > 64)
+    set->low[word + 1] |= (uint64_t)bits >> (64 - shift);
+}
+
+/**
+ * @brief Tests a bit of the high bit vector.
+ */
+static inline bool get_high(ef_set_s *set, uint64_t pos) {
+  return (set->high[pos / 64] >> (pos % 64)) & 1;
+}
+
+/**
+ * @brief Finds the position of the set bit of a given rank in a word.
+ *
+ * @param word The word.
+ * @param r The rank of the bit, lower than the number of set bits of the word.
+ * @return The position of the bit in the word.
+ */
+static inline int select_in_word(uint64_t word, int r) {
+  for (int i = 0; i < r; i++)
+    word &= word - 1; // clear the lowest set bit
+  return __builtin_ctzll(word);
+}
+
+/**
+ * @brief Finds the position of the one (or zero) of a given rank in the high bit vector.
+ *
+ * The scan starts from the closest sample and counts the bits of whole words with popcount.
+ *
+ * @param set The compressed set.
+ * @param r The rank of the bit.
+ * @param bit true to look for a one, false to look for a zero.
+ * @return The position of the bit.
+ */
+static uint64_t select_high(ef_set_s *set, uint64_t r, bool bit) {
+  uint64_t pos = (bit ? set->ones : set->zeros)[r / SAMPLE];
+  r %= SAMPLE;
+  uint64_t word = pos / 64;
+  uint64_t bits = bit ? set->high[word] : ~set->high[word];
+  bits &= ~0ull << (pos % 64);
+  for (;;) {
+    uint64_t count = __builtin_popcountll(bits);
+    if (r < count)
+      return word * 64 + select_in_word(bits, r);
+    r -= count;
+    word++;
+    bits = bit ? set->high[word] : ~set->high[word];
+  }
+}
+
+/**
+ * @brief Builds a compressed set from sorted values.
+ * @param values The values, in strictly ascending order.
+ * @param n The number of values.
+ * @return A pointer to the newly created set.
+ */
+ef_set_s *ef_create(const int *values, int n) {
+  ef_set_s *set = calloc(1, sizeof(ef_set_s));
+  assert(set != NULL);
+  set->n = n;
+  if (n == 0)
+    return set;
+  set->min = values[0];
+  set->max_offset = (uint32_t)values[n - 1] - (uint32_t)values[0];
+  uint64_t universe = (uint64_t)set->max_offset + 1;
+  while (((uint64_t)n << (set->low_bits + 1)) <= universe)
+    set->low_bits++;
+  uint64_t zeros = (set->max_offset >> set->low_bits) + 1;
+  set->high_size = n + zeros;
+  set->low = calloc(((uint64_t)n * set->low_bits + 63) / 64 + 1, sizeof(uint64_t));
+  set->high = calloc((set->high_size + 63) / 64 + 1, sizeof(uint64_t));
+  set->ones = malloc(((n - 1) / SAMPLE + 1) * sizeof(uint64_t));
+  set->zeros = malloc(((zeros - 1) / SAMPLE + 1) * sizeof(uint64_t));
+  assert(set->low != NULL && set->high != NULL && set->ones != NULL && set->zeros != NULL);
+  for (int i = 0; i < n; i++) {
+    assert(i == 0 || values[i - 1] < values[i]);
+    uint32_t offset = (uint32_t)values[i] - (uint32_t)set->min;
+    uint64_t pos = (offset >> set->low_bits) + i;
+    set->high[pos / 64] |= 1ull << (pos % 64);
+    set_low(set, i, offset & (uint32_t)((1ull << set->low_bits) - 1));
+  }
+  uint64_t nb_ones = 0, nb_zeros = 0;
+  for (uint64_t pos = 0; pos < set->high_size; pos++) {
+    if (get_high(set, pos)) {
+      if (nb_ones % SAMPLE == 0)
+        set->ones[nb_ones / SAMPLE] = pos;
+      nb_ones++;
+    } else {
+      if (nb_zeros % SAMPLE == 0)
+        set->zeros[nb_zeros / SAMPLE] = pos;
+      nb_zeros++;
+    }
+  }
+  return set;
+}
+
+/**
+ * @brief Builds a compressed set holding the values of a binary search tree.
+ * @param tree The binary search tree (can be NULL if the tree is empty).
+ * @return A pointer to the newly created set.
+ */
+ef_set_s *bst_compress(binary_tree_s *tree) {
+  int n = binary_tree_nodes(tree);
+  int *values = malloc((n > 0 ? n : 1) * sizeof(int));
+  assert(values != NULL);
+  n = binary_tree_to_array(tree, values);
+  ef_set_s *set = ef_create(values, n);
+  free(values);
+  return set;
+}
+
+/**
+ * @brief Counts the values of the set.
+ * @param set The compressed set.
+ * @return The number of values.
+ */
+int ef_size(ef_set_s *set) {
+  assert(set != NULL);
+  return set->n;
+}
+
+/**
+ * @brief Reads the value of a given rank.
+ * @param i The rank, from 0 (the minimum) to ef_size(set)-1.
+ * @param set The compressed set.
+ * @return The (i+1)-th smallest value.
+ * @note Asserts that the rank is valid.
+ */
+int ef_select(int i, ef_set_s *set) {
+  assert(set != NULL && i >= 0 && i < set->n);
+  uint64_t high = select_high(set, i, true) - i;
+  uint32_t offset = (uint32_t)(high << set->low_bits) | get_low(set, i);
+  return (int)((uint32_t)set->min + offset);
+}
+
+/**
+ * @brief Counts the values of the set lower than a given value.
+ *
+ * The zeros closing the previous high bucket and the bucket of the given value give the ranks of the
+ * values sharing its high bits, then a binary search on their low bits, which are sorted, finds the
+ * first one not lower than the given value.
+ *
+ * @param value The value.
+ * @param set The compressed set.
+ * @return The number of values strictly lower than value.
+ */
+int ef_rank(int value, ef_set_s *set) {
+  assert(set != NULL);
+  if (set->n == 0 || value <= set->min)
+    return 0;
+  uint32_t offset = (uint32_t)value - (uint32_t)set->min;
+  if (offset > set->max_offset)
+    return set->n;
+  uint64_t high = offset >> set->low_bits;
+  uint32_t low = offset & (uint32_t)((1ull << set->low_bits) - 1);
+  uint64_t first = (high == 0) ? 0 : select_high(set, high - 1, false) + 1 - high;
+  uint64_t last = select_high(set, high, false) - high; // rank following the bucket
+  while (first < last) {
+    uint64_t middle = first + (last - first) / 2;
+    if (get_low(set, middle) < low)
+      first = middle + 1;
+    else
+      last = middle;
+  }
+  return (int)first;
+}
+
+/**
+ * @brief Checks whether a value belongs to the set.
+ * @param value The value to find.
+ * @param set The compressed set.
+ * @return true if the value is in the set, false otherwise.
+ */
+bool ef_find(int value, ef_set_s *set) {
+  int i = ef_rank(value, set);
+  return i < set->n && ef_select(i, set) == value;
+}
+
+/**
+ * @brief Finds the greatest value of the set lower or equal to a given value.
+ * @param value The value.
+ * @param set The compressed set.
+ * @param floor Output : the greatest value lower or equal to value, if any.
+ * @return true if such a value exists, false otherwise.
+ */
+bool ef_floor(int value, ef_set_s *set, int *floor) {
+  int i = ef_rank(value, set);
+  if (i < set->n && ef_select(i, set) == value) {
+    *floor = value;
+    return true;
+  }
+  if (i == 0)
+    return false;
+  *floor = ef_select(i - 1, set);
+  return true;
+}
+
+/**
+ * @brief Computes the memory used by the set.
+ * @param set The compressed set.
+ * @return The size of the set in bytes.
+ */
+size_t ef_bytes(ef_set_s *set) {
+  assert(set != NULL);
+  size_t bytes = sizeof(ef_set_s);
+  if (set->n > 0) {
+    uint64_t zeros = (set->max_offset >> set->low_bits) + 1;
+    bytes += (((uint64_t)set->n * set->low_bits + 63) / 64 + 1) * sizeof(uint64_t);
+    bytes += ((set->high_size + 63) / 64 + 1) * sizeof(uint64_t);
+    bytes += ((set->n - 1) / SAMPLE + 1) * sizeof(uint64_t);
+    bytes += ((zeros - 1) / SAMPLE + 1) * sizeof(uint64_t);
+  }
+  return bytes;
+}
+
+/**
+ * @brief Erases the set.
+ * @param set The compressed set.
+ */
+void ef_free(ef_set_s *set) {
+  assert(set != NULL);
+  free(set->low);
+  free(set->high);
+  free(set->ones);
+  free(set->zeros);
+  free(set);
+}
@@ -2,7 +2,17 @@
  * @file heap.c
  * @brief Structure and functions for managing a heap data structure. 
  *
- * This file contains the implementation a heap using arrays. 
+ * This file contains the implementation a heap using arrays. The array grows geometrically (its
+ * capacity doubles when it is full), so that n additions cost O(n) copies in total, and an empty heap
+ * allocates no array at all.
+ *
+ * The heap is d-ary: each node has HEAP_ARITY children (2 by default, set with -DHEAP_ARITY=4 for
+ * instance). The children of node i are at the indices i*d+1 to i*d+d and its parent at (i-1)/d. A larger
+ * arity makes the heap shallower (log_d n levels) and keeps the children of a node in one or two
+ * cache lines, at the cost of d-1 comparisons per level when moving an element down.
+ *
+ * The algorithms on the array come from heap_template.h, which defines the same heap for other
+ * element types and orders (min-heaps, structs).
  *
  * @author Grimaud
  * @date 04/15/2024
@@ -12,24 +22,32 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include "heap.h"
+#include "heap_template.h"
 
-#define HEAP_MAX_SIZE 1000
+#ifndef HEAP_ARITY
+/**
+ * @brief Number of children of each node of the heap.
+ */
+#define HEAP_ARITY 2
+#endif
 
-void swap(int *a, int *b) {
-  int tmp=*a;
-  *a=*b;
-  *b=tmp;
-}
+/*
+ * The sifts, the heapify and the bottom-up removal of a max-heap of int (heap_int_sift_up(),
+ * heap_int_heapify(), heap_int_remove_top()...), expanded from heap_template.h.
+ */
+HEAP_DEFINE(heap_int, int, HEAP_MAX, HEAP_ARITY)
 
 /** 
  * @struct heap
  * @brief Structure of the heap.
  */
 typedef struct heap {
-  int array[HEAP_MAX_SIZE];
-  int nb_elements;
+  int *array;          /**< The elements, NULL while the capacity is 0 */
+  size_t nb_elements;  /**< Number of elements */
+  size_t capacity;     /**< Number of elements the array can hold */
 } heap_s;
 
 /** 
@@ -37,32 +55,143 @@ typedef struct heap {
  * @return A pointer to the newly created empty heap.
  */
 heap_s *heap_create() {
+  return heap_create_with_capacity(0);
+}
+
+/** 
+ * @brief Creates a new heap able to hold a given number of elements without growing.
+ * @param capacity The expected number of elements (0 to allocate on the first addition).
+ * @return A pointer to the newly created empty heap.
+ */
+heap_s *heap_create_with_capacity(size_t capacity) {
   heap_s *res=malloc(sizeof(heap_s));
   assert(res!=NULL);
   res->nb_elements=0;
+  res->capacity=capacity;
+  res->array=NULL;
+  if(capacity>0) {
+    res->array=malloc(capacity*sizeof(int));
+    assert(res->array!=NULL);
+  }
   return res;
 }
 
+/** 
+ * @brief Creates a heap holding the elements of an array, in O(n).
+ *
+ * The heap is built bottom-up (Floyd): each inner node, from the last one to the root, is moved down
+ * below its larger children, which costs less than 2n comparisons in total, instead of the O(n log n)
+ * of n heap_add().
+ * @param array The elements.
+ * @param n The number of elements.
+ * @param take_ownership If true, the heap adopts the array, which must have been allocated with
+ * malloc() and must no longer be used by the caller; otherwise the elements are copied.
+ * @return A pointer to the newly created heap.
+ */
+heap_s *heap_from_array(int *array, size_t n, bool take_ownership) {
+  assert(array!=NULL || n==0);
+  heap_s *res;
+  if(take_ownership) {
+    res=heap_create_with_capacity(0);
+    res->array=array;
+    res->capacity=n;
+  } else {
+    res=heap_create_with_capacity(n);
+    if(n>0)
+      memcpy(res->array, array, n*sizeof(int));
+  }
+  res->nb_elements=n;
+  heap_int_heapify(res->array, n);
+  return res;
+}
+
+/**
+ * @brief Sorts an array in ascending order with heapsort, in place.
+ *
+ * The array is heapified into a max-heap of arity HEAP_ARITY, then its maximum is moved to the end
+ * n-1 times; no memory is allocated.
+ * @param array The array, which may be NULL if n is 0.
+ * @param n The number of elements of the array.
+ */
+void heap_sort(int *array, size_t n) {
+  assert(array!=NULL || n==0);
+  heap_int_sort(array, n);
+}
+
+/** 
+ * @brief Changes the capacity of the heap.
+ * @param heap The address of the current heap.
+ * @param capacity The new capacity, not lower than the number of elements.
+ */
+static void heap_resize(heap_s *heap, size_t capacity) {
+  assert(capacity>=heap->nb_elements);
+  if(capacity==0) {
+    free(heap->array);
+    heap->array=NULL;
+  } else {
+    int *array=realloc(heap->array, capacity*sizeof(int));
+    assert(array!=NULL);
+    heap->array=array;
+  }
+  heap->capacity=capacity;
+}
+
+/** 
+ * @brief Reduces the capacity of the heap to its number of elements.
+ * @param heap The address of the current heap.
+ * @return The address of the updated heap.
+ */
+heap_s *heap_shrink_to_fit(heap_s *heap) {
+  assert(heap!=NULL);
+  if(heap->capacity>heap->nb_elements)
+    heap_resize(heap, heap->nb_elements);
+  return heap;
+}
+
+/** 
+ * @brief Returns the number of elements of the heap.
+ * @param heap The address of the current heap.
+ * @return The number of elements.
+ */
+size_t heap_size(heap_s *heap) {
+  assert(heap!=NULL);
+  return heap->nb_elements;
+}
+
+/** 
+ * @brief Returns the number of elements the heap can hold without growing.
+ * @param heap The address of the current heap.
+ * @return The capacity.
+ */
+size_t heap_capacity(heap_s *heap) {
+  assert(heap!=NULL);
+  return heap->capacity;
+}
+
 /** 
  * @brief Adds a given value to the heap.
  * @param value A new value to add.
  * @param heap The address of the current heap.
  * @return The address of the updated heap.
- * @note Asserts that the heap is already created and has enough space.
+ * @note Asserts that the heap is already created. The capacity doubles when the heap is full.
  */
 heap_s *heap_add(int value, heap_s *heap) {
   assert(heap!=NULL);
-  assert(heap->nb_elements<HEAP_MAX_SIZE);
-  int i=heap->nb_elements;
+  if(heap->nb_elements==heap->capacity)
+    heap_resize(heap, (heap->capacity==0)?HEAP_INITIAL_CAPACITY:2*heap->capacity);
+  heap_int_sift_up(heap->array, heap->nb_elements, value);
   heap->nb_elements++;
-  heap->array[i]=value;
-  while(i>0 && heap->array[i] > heap->array[(i-1)/2]) {
-    swap(&(heap->array[i]),&(heap->array[(i-1)/2])); // restore the heap property
-    i=(i-1)/2; // go forward to the parent
-  }
   return heap;
 }
 
+/** 
+ * @brief Returns the number of children of each node, HEAP_ARITY.
+ * @return The arity of the heap.
+ */
+int heap_arity(void) {
+  return HEAP_ARITY;
+}
+
 /** 
  * @brief Tests if the heap is empty.
  * @param heap The address of the current heap.
@@ -92,23 +221,46 @@ int heap_peek(heap_s *heap) {
  * @note Asserts that the heap is not empty.
  */
 heap_s *heap_remove(heap_s *heap) {
-  assert(heap!=NULL);
-  heap->array[0]=heap->array[heap->nb_elements-1];
+  assert(!heap_empty(heap));
+  heap_int_remove_top(heap->array, heap->nb_elements);
   heap->nb_elements--;
-  int i=0; // index of the actual tree node
-  while(i<heap->nb_elements) {
-    int left_index = i*2+1;
-    int right_index = i*2+2;
-    int largest_index = i;
-    if(left_index<heap->nb_elements && heap->array[left_index] > heap->array[largest_index]) 
-      largest_index = left_index;
-    if(right_index<heap->nb_elements && heap->array[right_index] > heap->array[largest_index]) 
-      largest_index = right_index;
-    if(largest_index == i) 
-      break;
-    swap(&(heap->array[i]), &(heap->array[largest_index])); // restore the heap property
-    i=largest_index; // go forward to the child
+  return heap;
+}
+
+/** 
+ * @brief Moves all the elements of a heap into another one, and erases the emptied heap.
+ *
+ * The elements of the other heap are appended, then moved up one by one when they are few compared
+ * to the heap (each one costs at most the depth of the heap), or the whole array is heapified, in
+ * O(n), otherwise.
+ * @param heap The address of the heap which receives the elements.
+ * @param other The address of the heap to empty.
+ * @return The address of the updated heap.
+ */
+heap_s *heap_meld(heap_s *heap, heap_s *other) {
+  assert(heap!=NULL && other!=NULL);
+  size_t n=heap->nb_elements+other->nb_elements;
+  if(other->capacity>heap->capacity) { // keep the larger array
+    heap_s tmp=*heap;
+    *heap=*other;
+    *other=tmp;
+  }
+  if(n>heap->capacity)
+    heap_resize(heap, n);
+  size_t depth=0; // depth of the melded heap
+  for(size_t i=n; i>0; i=HEAP_PARENT(i, HEAP_ARITY))
+    depth++;
+  size_t m=other->nb_elements;
+  if(m*depth<n) {
+    for(size_t i=0; i<m; i++)
+      heap_int_sift_up(heap->array, heap->nb_elements++, other->array[i]);
+  } else {
+    if(m>0)
+      memcpy(heap->array+heap->nb_elements, other->array, m*sizeof(int));
+    heap->nb_elements=n;
+    heap_int_heapify(heap->array, n);
   }
+  heap_delete(other);
   return heap;
 }
 
@@ -118,7 +270,7 @@ heap_s *heap_remove(heap_s *heap) {
  * @note Asserts that the heap is already created.
  */
 void heap_print(heap_s *heap) {
-  int i;
+  size_t i;
   assert(heap!=NULL);
   printf("heap:\n");
   printf("┌─────%s",(heap->nb_elements>0)?"┬":"┐");
@@ -126,11 +278,11 @@ void heap_print(heap_s *heap) {
     printf("────%s",(i<heap->nb_elements-1)?"┬":"┐");
   printf("\n"); 
   printf("│index│");
-  for(int i=0;i<heap->nb_elements;i++) 
-    printf("% 4d│",i);
+  for(i=0;i<heap->nb_elements;i++) 
+    printf("%4zu│",i);
   printf("\n");
   printf("│value│");
-  for(int i=0;i<heap->nb_elements;i++) 
+  for(i=0;i<heap->nb_elements;i++) 
     printf("% 4d│",heap->array[i]);
   printf("\n");
   printf("└─────%s",(heap->nb_elements>0)?"┴":"┘");
@@ -145,6 +297,7 @@ void heap_print(heap_s *heap) {
  */
 void heap_delete(heap_s *heap) {
   assert(heap!=NULL);
+  free(heap->array);
   free(heap);
   return;
 }
@@ -0,0 +1,248 @@
+/**
+ * @file indexed_heap.c
+ * @brief Implementation of the min-heap with handles of indexed_heap.h.
+ *
+ * The elements are (key, handle) pairs in a d-ary heap array, with INDEXED_HEAP_ARITY children per
+ * node (4 by default: decrease-key moves up, which is cheaper in a shallower heap). A second array,
+ * indexed by handle, gives the position of each element in the heap array; every move of an element
+ * during a sift updates it.
+ *
+ * The handles are reused without a list of their own: the heap array holds the elements in its first
+ * nb_elements entries, and the handles which are no longer used in the next ones, up to the number
+ * of handles ever given. Removing an element frees the entry after the new last element, which is
+ * where its handle goes.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "indexed_heap.h"
+#include "heap_template.h"
+
+#ifndef INDEXED_HEAP_ARITY
+/**
+ * @brief Number of children of each node of the indexed heap.
+ */
+#define INDEXED_HEAP_ARITY 4
+#endif
+
+/**
+ * @brief Position of the handles which designate no element.
+ */
+#define NOT_IN_HEAP UINT32_MAX
+
+/**
+ * @struct entry
+ * @brief Element of the heap array, 8 bytes so that 4 children share half a cache line.
+ */
+typedef struct entry {
+  int key;          /**< The key */
+  uint32_t handle;  /**< The handle of the element */
+} entry_s;
+
+/**
+ * @struct indexed_heap
+ * @brief Structure of the indexed heap.
+ */
+typedef struct indexed_heap {
+  entry_s *entries;    /**< The elements, then the free handles */
+  uint32_t *position;  /**< Index in entries of the element of each handle, or NOT_IN_HEAP */
+  size_t nb_elements;  /**< Number of elements */
+  size_t nb_handles;   /**< Number of handles ever given, elements and free handles */
+  size_t capacity;     /**< Number of entries and positions allocated */
+} indexed_heap_s;
+
+/**
+ * @brief Puts an entry at an index of the heap array and records its position.
+ * @param heap The heap.
+ * @param i The index.
+ * @param entry The entry.
+ */
+static inline void place(indexed_heap_s *heap, size_t i, entry_s entry) {
+  heap->entries[i] = entry;
+  heap->position[entry.handle] = i;
+}
+
+/**
+ * @brief Moves an entry up from a hole until its parent is not greater, and fills the hole.
+ * @param heap The heap.
+ * @param i The index of the hole.
+ * @param entry The entry to place.
+ */
+static void sift_up(indexed_heap_s *heap, size_t i, entry_s entry) {
+  while (i > 0) {
+    size_t parent = HEAP_PARENT(i, INDEXED_HEAP_ARITY);
+    if (!(entry.key < heap->entries[parent].key))
+      break;
+    place(heap, i, heap->entries[parent]); // move the parent down into the hole
+    i = parent;
+  }
+  place(heap, i, entry);
+}
+
+/**
+ * @brief Returns the index of the smallest child of a node which has at least one child.
+ * @param heap The heap.
+ * @param first The index of the first child of the node.
+ * @return The index of the smallest child.
+ */
+static size_t smallest_child(indexed_heap_s *heap, size_t first) {
+  size_t n = heap->nb_elements;
+  size_t last = (first + INDEXED_HEAP_ARITY < n) ? first + INDEXED_HEAP_ARITY : n;
+  size_t smallest = first;
+  for (size_t child = first + 1; child < last; child++)
+    if (heap->entries[child].key < heap->entries[smallest].key)
+      smallest = child;
+  return smallest;
+}
+
+/**
+ * @brief Moves an entry down from a hole until its children are not smaller, and fills the hole.
+ * @param heap The heap.
+ * @param i The index of the hole.
+ * @param entry The entry to place.
+ */
+static void sift_down(indexed_heap_s *heap, size_t i, entry_s entry) {
+  while (HEAP_FIRST_CHILD(i, INDEXED_HEAP_ARITY) < heap->nb_elements) {
+    size_t smallest = smallest_child(heap, HEAP_FIRST_CHILD(i, INDEXED_HEAP_ARITY));
+    if (!(heap->entries[smallest].key < entry.key))
+      break;
+    place(heap, i, heap->entries[smallest]); // move the child up into the hole
+    i = smallest;
+  }
+  place(heap, i, entry);
+}
+
+/**
+ * @brief Removes the element at an index of the heap array and frees its handle.
+ *
+ * Bottom-up deletion, as in heap.c: the hole goes down along the smallest children to a leaf, then
+ * the last element moves up from there, possibly above the index.
+ * @param heap The heap.
+ * @param i The index of the element, lower than the number of elements.
+ * @return The handle of the element.
+ */
+static heap_handle_t remove_at(indexed_heap_s *heap, size_t i) {
+  uint32_t handle = heap->entries[i].handle;
+  size_t n = --heap->nb_elements;
+  entry_s last = heap->entries[n];
+  if (i < n) {
+    while (HEAP_FIRST_CHILD(i, INDEXED_HEAP_ARITY) < n) {
+      size_t smallest = smallest_child(heap, HEAP_FIRST_CHILD(i, INDEXED_HEAP_ARITY));
+      place(heap, i, heap->entries[smallest]);
+      i = smallest;
+    }
+    sift_up(heap, i, last);
+  }
+  heap->entries[n].handle = handle; // the first free handle
+  heap->position[handle] = NOT_IN_HEAP;
+  return handle;
+}
+
+/*
+ * The functions of indexed_heap.h are documented in the header.
+ */
+
+indexed_heap_s *indexed_heap_create(void) {
+  indexed_heap_s *res = malloc(sizeof(indexed_heap_s));
+  assert(res != NULL);
+  res->entries = NULL;
+  res->position = NULL;
+  res->nb_elements = 0;
+  res->nb_handles = 0;
+  res->capacity = 0;
+  return res;
+}
+
+size_t indexed_heap_size(indexed_heap_s *heap) {
+  assert(heap != NULL);
+  return heap->nb_elements;
+}
+
+bool indexed_heap_empty(indexed_heap_s *heap) {
+  assert(heap != NULL);
+  return heap->nb_elements == 0;
+}
+
+heap_handle_t indexed_heap_add(indexed_heap_s *heap, int key) {
+  assert(heap != NULL);
+  if (heap->nb_elements == heap->nb_handles) { // no free handle: a new one
+    if (heap->nb_handles == heap->capacity) {
+      heap->capacity = (heap->capacity == 0) ? HEAP_INITIAL_CAPACITY : 2 * heap->capacity;
+      assert(heap->capacity < UINT32_MAX); // handles and positions fit in 32 bits
+      heap->entries = realloc(heap->entries, heap->capacity * sizeof(entry_s));
+      heap->position = realloc(heap->position, heap->capacity * sizeof(uint32_t));
+      assert(heap->entries != NULL && heap->position != NULL);
+    }
+    heap->entries[heap->nb_handles].handle = heap->nb_handles;
+    heap->nb_handles++;
+  }
+  entry_s entry = { key, heap->entries[heap->nb_elements].handle };
+  sift_up(heap, heap->nb_elements++, entry);
+  return entry.handle;
+}
+
+bool indexed_heap_contains(indexed_heap_s *heap, heap_handle_t handle) {
+  assert(heap != NULL);
+  return handle < heap->nb_handles && heap->position[handle] != NOT_IN_HEAP;
+}
+
+int indexed_heap_key(indexed_heap_s *heap, heap_handle_t handle) {
+  assert(indexed_heap_contains(heap, handle));
+  return heap->entries[heap->position[handle]].key;
+}
+
+int indexed_heap_peek(indexed_heap_s *heap) {
+  assert(!indexed_heap_empty(heap));
+  return heap->entries[0].key;
+}
+
+heap_handle_t indexed_heap_peek_handle(indexed_heap_s *heap) {
+  assert(!indexed_heap_empty(heap));
+  return heap->entries[0].handle;
+}
+
+heap_handle_t indexed_heap_remove(indexed_heap_s *heap) {
+  assert(!indexed_heap_empty(heap));
+  return remove_at(heap, 0);
+}
+
+void indexed_heap_decrease_key(indexed_heap_s *heap, heap_handle_t handle, int key) {
+  assert(indexed_heap_contains(heap, handle));
+  size_t i = heap->position[handle];
+  assert(key <= heap->entries[i].key);
+  heap->entries[i].key = key;
+  sift_up(heap, i, heap->entries[i]);
+}
+
+void indexed_heap_increase_key(indexed_heap_s *heap, heap_handle_t handle, int key) {
+  assert(indexed_heap_contains(heap, handle));
+  size_t i = heap->position[handle];
+  assert(key >= heap->entries[i].key);
+  heap->entries[i].key = key;
+  sift_down(heap, i, heap->entries[i]);
+}
+
+void indexed_heap_update(indexed_heap_s *heap, heap_handle_t handle, int key) {
+  if (key < indexed_heap_key(heap, handle))
+    indexed_heap_decrease_key(heap, handle, key);
+  else
+    indexed_heap_increase_key(heap, handle, key);
+}
+
+void indexed_heap_erase(indexed_heap_s *heap, heap_handle_t handle) {
+  assert(indexed_heap_contains(heap, handle));
+  remove_at(heap, heap->position[handle]);
+}
+
+void indexed_heap_delete(indexed_heap_s *heap) {
+  assert(heap != NULL);
+  free(heap->entries);
+  free(heap->position);
+  free(heap);
+}
@@ -15,8 +15,10 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <limits.h>
 #include <assert.h>
 #include "bst.h"
+#include "ef_set.h"
 
 int verbose=0;
 
@@ -34,6 +36,65 @@ int is_number(char *s) {
   return *s == '\0';
 }
 
+/**
+ * @brief Selects the engine named in the program name, e.g. "avl" for "bin/avl_bst" or "bin/test_avl_bst".
+ *
+ * @param first_arg The program name.
+ */
+void default_engine(char *first_arg) {
+  char name[64];
+  char *base = strrchr(first_arg, '/');
+  base = (base == NULL) ? first_arg : base + 1;
+  snprintf(name, sizeof(name), "%s", base);
+  char *suffix = strstr(name, "_bst");
+  if (suffix != NULL)
+    *suffix = '\0';
+  char *engine_name = strrchr(name, '_'); // skip a profile prefix such as "test_"
+  engine_name = (engine_name == NULL) ? name : engine_name + 1;
+  const bst_ops_t *engine = bst_engine(engine_name);
+  if (engine != NULL)
+    bst_use(engine);
+}
+
+/**
+ * @brief Checks ef_find(), ef_rank() and ef_floor() against the sorted values the set was built from.
+ *
+ * Each value, its neighbours and the extreme int values are looked for, so that every gap between two
+ * values and both ends of the set are probed.
+ *
+ * @param set The compressed set.
+ * @param values The values of the set, in ascending order.
+ * @param n The number of values.
+ * @return true if all the answers agree with the values, false otherwise.
+ */
+static bool check_compressed(ef_set_s *set, const int *values, int n) {
+  for (int i = -1; i <= n; i++) {
+    long long center = (i < 0) ? INT_MIN : (i == n) ? INT_MAX : values[i];
+    for (long long probe = center - 1; probe <= center + 1; probe++) {
+      if (probe < INT_MIN || probe > INT_MAX)
+        continue;
+      int rank = 0, high = n; // rank ends as the number of values lower than probe
+      while (rank < high) {
+        int middle = rank + (high - rank) / 2;
+        if (values[middle] < probe)
+          rank = middle + 1;
+        else
+          high = middle;
+      }
+      bool found = rank < n && values[rank] == probe;
+      int floor;
+      bool has_floor = ef_floor((int)probe, set, &floor);
+      if (ef_rank((int)probe, set) != rank || ef_find((int)probe, set) != found
+          || has_floor != (found || rank > 0)
+          || (has_floor && floor != (found ? values[rank] : values[rank - 1]))) {
+        fprintf(stderr, "/!\\ compressed set disagrees with the tree on %lld.\n", probe);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 /**
  * @brief Displays usage information for the program.
  */
@@ -42,12 +103,19 @@ void help(char *first_arg) {
   printf("Options:\n");
   printf("  -h, --help         Show this help message and exit.\n");
   printf("  -v, --verbose      Be verbose while processing commands.\n");
+  printf("  --engine=NAME      Use the engine NAME (by default, the engine of the program name [test_|pgo_]NAME_bst):\n");
+  printf("                    ");
+  for (const bst_ops_t *const *engine = bst_engines(); *engine != NULL; engine++)
+    printf(" %s", (*engine)->name);
+  printf("\n");
   printf("Commands:\n");
   printf("  p, print           Print the current state of the tree.\n");
   printf("  d_asc, dump_asc    Print all values in the binary search tree in the ascending order.\n");
   printf("  d_desc, dump_desc  Print all values in the binary search tree in the descending order.\n");
   printf("  f, find [number]   Find and display if a number is in the tree.\n");
   printf("  r, remove [number] Remove a number from the tree.\n");
+  printf("  c, compress        Print the size and the values of the tree compressed with Elias-Fano,\n");
+  printf("                     after checking its find, rank and floor operations against the tree.\n");
   printf("  Numbers:           Add number(s) to the tree.\n");
 }
 
@@ -61,6 +129,7 @@ void help(char *first_arg) {
 int main(int argc, char **argv) {
   char *argv0=argv[0];
   argc--;argv++;
+  default_engine(argv0);
   while(argc>0) { // Process options until first Command.
     if(strcmp(argv[0], "--help") == 0 || strcmp(argv[0], "-h") == 0) {
       help(argv0);
@@ -68,6 +137,14 @@ int main(int argc, char **argv) {
     } else if (strcmp(argv[0], "--verbose") ==0 || strcmp(argv[0], "-v")==0) {
       verbose=1;
       printf("Verbose output requested.\n");
+    } else if (strncmp(argv[0], "--engine=", 9) == 0) {
+      const bst_ops_t *engine = bst_engine(argv[0] + 9);
+      if (engine == NULL) {
+	fprintf(stderr,"unknown engine '%s'.\n",argv[0] + 9);
+	help(argv0);
+	return 1;
+      }
+      bst_use(engine);
     } else if(argv[0][0]=='-') {
       fprintf(stderr,"unknown option '%s'.\n",argv[1]);
       help(argv0);
@@ -81,6 +158,7 @@ int main(int argc, char **argv) {
     help(argv0);
     return 1;
   }
+  if(verbose) printf("Engine %s.\n", bst_current()->name);
   // create the tree used by the commands
   binary_tree_s *tree = NULL ;
   int step=0; 
@@ -126,6 +204,25 @@ int main(int argc, char **argv) {
 	  help(argv0);
 	  return 1;
 	}
+      } else if (strcmp(argv[0], "c") == 0 || strcmp(argv[0], "compress") == 0) {
+	if(verbose) printf("%02d) process compress\n",step);
+	ef_set_s *set = bst_compress(tree);
+	int n = ef_size(set);
+	printf("compressed : %d values in %zu bytes (%.2f bits per value)\n", n, ef_bytes(set),
+	       n > 0 ? 8.0 * ef_bytes(set) / n : 0.0);
+	for (int i = 0; i < n; i++)
+	  printf("%d ", ef_select(i, set));
+	printf("\n");
+	int *values = malloc((n > 0 ? n : 1) * sizeof(int));
+	assert(values != NULL);
+	bool ok = binary_tree_to_array(tree, values) == n && check_compressed(set, values, n);
+	free(values);
+	ef_free(set);
+	if (!ok) {
+	  binary_tree_free(tree);
+	  return 1;
+	}
+	argc--;argv++;
       } else if (is_number(argv[0])) {
 	int v = atoi(argv[0]);
 	argc--;argv++;
@@ -137,6 +234,15 @@ int main(int argc, char **argv) {
 	return 1;
       }
   }
+#ifdef BST_STATS
+  if(verbose && !bst_current()->stats) {
+    printf("Counters: unsupported by the %s engine.\n", bst_current()->name);
+  } else if(verbose) {
+    bst_stats_t stats = bst_stats_get();
+    printf("Counters: %lu comparisons, %lu visits, %lu rotations, %lu recolorings, %lu rebuilt, %lu allocations.\n",
+	   stats.comparisons, stats.visits, stats.rotations, stats.recolorings, stats.rebuilt, stats.allocations);
+  }
+#endif
   binary_tree_free(tree);
   return 0;
 }
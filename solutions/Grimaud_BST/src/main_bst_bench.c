@@ -0,0 +1,495 @@
+/**
+ * @file main_bst_bench.c
+ * @brief Benchmark of the binary search tree operations defined in bst.h.
+ *
+ * For every engine, key distribution and number of keys (from 10^3 by powers of ten), this program
+ * adds the keys to an empty tree, finds them all and removes them all, each run in a child process.
+ * It reports the time per operation of each phase, the throughput, the peak resident set size of the
+ * child and the height of the tree once filled, as a table, CSV or JSON.
+ *
+ * With --churn, it runs instead a delete-heavy churn on random keys: once the tree holds n distinct
+ * keys, each step removes a random key of the tree and adds a new key that is not in it, n times. It
+ * reports the time per operation and, per operation, the rotations and visited nodes counted by
+ * bst_stats (in the stats profile, i.e. bin/stats_bst_bench) and the cache misses of the hardware
+ * counters (when perf events are available), to compare how the balanced engines restructure their
+ * trees under removals.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "bst.h"
+#include "bench.h"
+
+/**
+ * @brief Distributions of the keys.
+ */
+static const char *const distributions[] = {"random", "sorted", "reverse", "zipf", "sawtooth", NULL};
+
+/**
+ * @brief Number of comparisons above which a run of the simple engine is skipped: on sorted, reverse and
+ * sawtooth keys its tree degenerates into long lists, i.e. quadratic time and a deep recursion.
+ */
+#define SIMPLE_MAX_COMPARISONS 100000000.0
+
+/**
+ * @brief Skew of the Zipfian distribution.
+ */
+#define ZIPF_THETA 0.99
+
+/**
+ * @struct bench_result_s
+ * @brief Measures of one run, sent by the child process to its parent.
+ */
+typedef struct bench_result {
+  int nodes;          /**< Number of values in the tree once filled */
+  int height;         /**< Height of the tree once filled */
+  double add_ns;      /**< Time per add_node(), in nanoseconds */
+  double find_ns;     /**< Time per find_node(), in nanoseconds */
+  double remove_ns;   /**< Time per remove_node(), in nanoseconds */
+  double ops_per_s;   /**< Operations (additions, finds and removals) per second */
+  long peak_rss_kb;   /**< Peak resident set size of the child, in kilobytes */
+  double churn_ns;    /**< Time per operation of the churn, in nanoseconds */
+  double rotations;   /**< Rotations per operation of the churn, negative if not counted */
+  double visits;      /**< Visited nodes per operation of the churn, negative if not counted */
+  double misses;      /**< Cache misses per operation of the churn, negative if not counted */
+} bench_result_s;
+
+/**
+ * @brief Generates the keys of a distribution.
+ *
+ * random keys are uniform over the positive integers. sorted and reverse keys are 0..n-1 in increasing
+ * and decreasing order. zipf keys are ranks drawn from a Zipfian distribution of skew ZIPF_THETA over
+ * n ranks (see zipf_s), so that a few keys repeat very often. sawtooth keys increase in
+ * sqrt(n) teeth of sqrt(n) keys, each tooth interleaved with the others.
+ *
+ * @param distribution The name of the distribution.
+ * @param n The number of keys.
+ * @param keys The array receiving the n keys.
+ */
+static void generate_keys(const char *distribution, int n, int *keys) {
+  if (strcmp(distribution, "random") == 0) {
+    for (int i = 0; i < n; i++)
+      keys[i] = (int)(bench_random() >> 33);
+  } else if (strcmp(distribution, "sorted") == 0) {
+    for (int i = 0; i < n; i++)
+      keys[i] = i;
+  } else if (strcmp(distribution, "reverse") == 0) {
+    for (int i = 0; i < n; i++)
+      keys[i] = n - 1 - i;
+  } else if (strcmp(distribution, "zipf") == 0) {
+    zipf_s zipf;
+    zipf_init(&zipf, n, ZIPF_THETA);
+    for (int i = 0; i < n; i++)
+      keys[i] = bench_scramble(zipf_next(&zipf));
+  } else { // sawtooth
+    int tooth = (int)sqrt(n);
+    if (tooth < 1)
+      tooth = 1;
+    int teeth = (n + tooth - 1) / tooth;
+    for (int i = 0; i < n; i++)
+      keys[i] = (i % tooth) * teeth + i / tooth;
+  }
+}
+
+/**
+ * @brief Adds, finds and removes the keys of a distribution with the current engine.
+ *
+ * @param distribution The name of the distribution.
+ * @param n The number of keys.
+ * @param result The measures, but peak_rss_kb.
+ * @return false if the keys could not be allocated.
+ */
+static bool bench_run(const char *distribution, int n, bench_result_s *result) {
+  int *keys = malloc(n * sizeof(int));
+  if (keys == NULL)
+    return false;
+  generate_keys(distribution, n, keys);
+  binary_tree_s *tree = NULL;
+  int found = 0;
+  double start = bench_now_ns();
+  for (int i = 0; i < n; i++)
+    tree = add_node(keys[i], tree);
+  double added = bench_now_ns();
+  for (int i = 0; i < n; i++)
+    found += find_node(keys[i], tree);
+  double finds = bench_now_ns();
+  result->nodes = binary_tree_nodes(tree);
+  result->height = binary_tree_height(tree);
+  double removals = bench_now_ns();
+  for (int i = 0; i < n; i++)
+    tree = remove_node(keys[i], tree);
+  double end = bench_now_ns();
+  binary_tree_free(tree);
+  free(keys);
+  if (found != n)
+    fprintf(stderr, "%s: %d keys of %d found.\n", bst_current()->name, found, n);
+  result->add_ns = (added - start) / n;
+  result->find_ns = (finds - added) / n;
+  result->remove_ns = (end - removals) / n;
+  result->ops_per_s = 3.0 * n / ((added - start) + (finds - added) + (end - removals)) * 1e9;
+  return true;
+}
+
+/**
+ * @brief Opens the hardware counter of the cache misses of the calling process.
+ *
+ * @return The file descriptor of the counter, -1 if perf events are not available.
+ */
+static int cache_misses_open(void) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = PERF_COUNT_HW_CACHE_MISSES;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/**
+ * @brief Reads the hardware counter of the cache misses.
+ *
+ * @param fd The file descriptor of the counter, or -1.
+ * @return The number of cache misses since the counter was opened, -1 if it could not be read.
+ */
+static long long cache_misses_read(int fd) {
+  long long count;
+  if (fd < 0 || read(fd, &count, sizeof(count)) != (ssize_t)sizeof(count))
+    return -1;
+  return count;
+}
+
+/**
+ * @brief Draws random keys until one is not in a tree.
+ *
+ * @param tree The tree.
+ * @return A key that is not in the tree.
+ */
+static int churn_new_key(binary_tree_s *tree) {
+  int key;
+  do
+    key = (int)(bench_random() >> 33);
+  while (find_node(key, tree));
+  return key;
+}
+
+/**
+ * @brief Runs the delete-heavy churn on random keys with the current engine.
+ *
+ * The tree is filled with n distinct random keys, then each step removes a random key of the tree and
+ * adds in its place a new random key drawn by churn_new_key(), n times, so that the tree keeps n keys.
+ * A step thus counts three operations: a removal, a find that misses (rarely more) and an addition.
+ *
+ * @param n The number of keys.
+ * @param result The height of the tree after the churn, and the churn_ns, rotations, visits and
+ * misses measures.
+ * @return false if the keys could not be allocated.
+ */
+static bool churn_run(int n, bench_result_s *result) {
+  int *keys = malloc(n * sizeof(int));
+  if (keys == NULL)
+    return false;
+  binary_tree_s *tree = NULL;
+  for (int i = 0; i < n; i++) {
+    keys[i] = churn_new_key(tree);
+    tree = add_node(keys[i], tree);
+  }
+  int fd = cache_misses_open();
+  bst_stats_reset();
+  long long misses = cache_misses_read(fd);
+  double start = bench_now_ns();
+  for (int i = 0; i < n; i++) {
+    int j = (int)(bench_random() % n);
+    tree = remove_node(keys[j], tree);
+    keys[j] = churn_new_key(tree);
+    tree = add_node(keys[j], tree);
+  }
+  double end = bench_now_ns();
+  long long misses_end = cache_misses_read(fd);
+  bst_stats_t stats = bst_stats_get();
+  if (fd >= 0)
+    close(fd);
+  double operations = 3.0 * n;
+  result->nodes = binary_tree_nodes(tree);
+  result->height = binary_tree_height(tree);
+  result->churn_ns = (end - start) / operations;
+#ifdef BST_STATS
+  bool counted = bst_current()->stats;
+#else
+  bool counted = false;
+#endif
+  result->rotations = counted ? stats.rotations / operations : -1;
+  result->visits = counted ? stats.visits / operations : -1;
+  result->misses = (misses >= 0 && misses_end >= 0) ? (misses_end - misses) / operations : -1;
+  binary_tree_free(tree);
+  free(keys);
+  return true;
+}
+
+/**
+ * @brief Prints a measure per operation of the churn, or a placeholder if it was not counted.
+ *
+ * @param value The measure, negative if it was not counted.
+ * @param format The output format: table, csv or json.
+ * @param separator The text printed before the measure.
+ */
+static void print_measure(double value, const char *format, const char *separator) {
+  printf("%s", separator);
+  if (value >= 0)
+    printf(strcmp(format, "table") == 0 ? "%10.2f" : "%.2f", value);
+  else if (strcmp(format, "table") == 0)
+    printf("%10s", "-");
+  else if (strcmp(format, "json") == 0)
+    printf("null");
+}
+
+/**
+ * @brief Checks whether a run would degenerate, i.e. whether the simple engine would build lists.
+ *
+ * @param engine The engine.
+ * @param distribution The name of the distribution.
+ * @param n The number of keys.
+ * @return true if the run should be skipped.
+ */
+static bool degenerate(const bst_ops_t *engine, const char *distribution, long n) {
+  double height = 0; // expected height of the simple tree, ignoring the logarithmic ones
+  if (engine != &simple_bst_ops)
+    return false;
+  if (strcmp(distribution, "sorted") == 0 || strcmp(distribution, "reverse") == 0)
+    height = n;
+  else if (strcmp(distribution, "sawtooth") == 0)
+    height = 2 * sqrt(n);
+  return n * height / 2 > SIMPLE_MAX_COMPARISONS;
+}
+
+/**
+ * @brief Runs a benchmark in a child process, so that its peak resident set size is its own.
+ *
+ * @param engine The engine.
+ * @param distribution The name of the distribution, ignored by the churn.
+ * @param n The number of keys.
+ * @param seed The seed of the keys.
+ * @param churn Whether to run the churn rather than the additions, finds and removals.
+ * @param result The measures.
+ * @return false if the child process failed.
+ */
+static bool bench_fork(const bst_ops_t *engine, const char *distribution, int n, uint64_t seed,
+                       bool churn, bench_result_s *result) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    perror("pipe");
+    return false;
+  }
+  fflush(stdout);
+  pid_t pid = fork();
+  if (pid < 0) {
+    perror("fork");
+    return false;
+  }
+  if (pid == 0) {
+    close(fds[0]);
+    bst_use(engine);
+    bench_seed(seed);
+    bool ok = churn ? churn_run(n, result) : bench_run(distribution, n, result);
+    if (ok && write(fds[1], result, sizeof(*result)) != (ssize_t)sizeof(*result))
+      ok = false;
+    _exit(ok ? 0 : 1);
+  }
+  close(fds[1]);
+  ssize_t size = read(fds[0], result, sizeof(*result));
+  close(fds[0]);
+  int status;
+  struct rusage usage;
+  if (wait4(pid, &status, 0, &usage) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0
+      || size != (ssize_t)sizeof(*result))
+    return false;
+  result->peak_rss_kb = usage.ru_maxrss;
+  return true;
+}
+
+/**
+ * @brief Displays usage information for the program.
+ */
+static void help(char *first_arg) {
+  printf("Usage: %s [options]\n", first_arg);
+  printf("Options:\n");
+  printf("  -h, --help              Show this help message and exit.\n");
+  printf("  --engines=A,B,...       Benchmark these engines (default: all):\n");
+  printf("                         ");
+  for (const bst_ops_t *const *engine = bst_engines(); *engine != NULL; engine++)
+    printf(" %s", (*engine)->name);
+  printf("\n");
+  printf("  --distributions=A,B,... Use these key distributions (default: all):\n");
+  printf("                         ");
+  for (int i = 0; distributions[i] != NULL; i++)
+    printf(" %s", distributions[i]);
+  printf("\n");
+  printf("  --min=N                 Smallest number of keys (default: 1000).\n");
+  printf("  --max=N                 Largest number of keys, up to 100000000 (default: 1000000).\n");
+  printf("  --seed=S                Seed of the keys (default: 1).\n");
+  printf("  --format=F              Output as table, csv or json (default: table).\n");
+  printf("  --churn                 Run the delete-heavy churn on random keys instead; the rotations and\n");
+  printf("                          visits are only counted by the stats profile, bin/stats_bst_bench.\n");
+}
+
+/**
+ * @brief Runs the churn for the selected engines and numbers of keys and prints its measures.
+ *
+ * @param engines The names of the engines, separated by commas, NULL for all of them.
+ * @param min The smallest number of keys.
+ * @param max The largest number of keys.
+ * @param seed The seed of the keys.
+ * @param format The output format: table, csv or json.
+ * @return 0 on success, 1 if a run failed.
+ */
+static int churn_main(const char *engines, long min, long max, uint64_t seed, const char *format) {
+  bool table = strcmp(format, "table") == 0, csv = strcmp(format, "csv") == 0;
+  if (table)
+    printf("%-10s %10s %10s %7s %10s %10s %10s %10s\n", "engine", "keys", "nodes", "height", "churn ns",
+           "rot/op", "visits/op", "misses/op");
+  else if (csv)
+    printf("engine,keys,nodes,height,churn_ns,rotations_per_op,visits_per_op,misses_per_op\n");
+  else
+    printf("[");
+  int failures = 0;
+  bool first = true;
+  for (const bst_ops_t *const *engine = bst_engines(); *engine != NULL; engine++) {
+    if (!bench_in_list(engines, (*engine)->name))
+      continue;
+    for (long n = min; n <= max; n *= 10) {
+      bench_result_s r;
+      if (!bench_fork(*engine, NULL, (int)n, seed, true, &r)) {
+        fprintf(stderr, "%s churn %ld: run failed.\n", (*engine)->name, n);
+        failures++;
+        continue;
+      }
+      if (table)
+        printf("%-10s %10ld %10d %7d %10.1f", (*engine)->name, n, r.nodes, r.height, r.churn_ns);
+      else if (csv)
+        printf("%s,%ld,%d,%d,%.1f", (*engine)->name, n, r.nodes, r.height, r.churn_ns);
+      else
+        printf("%s\n  {\"engine\": \"%s\", \"keys\": %ld, \"nodes\": %d, \"height\": %d, "
+               "\"churn_ns\": %.1f", first ? "" : ",", (*engine)->name, n, r.nodes, r.height, r.churn_ns);
+      print_measure(r.rotations, format, table ? " " : csv ? "," : ", \"rotations_per_op\": ");
+      print_measure(r.visits, format, table ? " " : csv ? "," : ", \"visits_per_op\": ");
+      print_measure(r.misses, format, table ? " " : csv ? "," : ", \"misses_per_op\": ");
+      printf(table || csv ? "\n" : "}");
+      first = false;
+    }
+  }
+  if (!table && !csv)
+    printf("\n]\n");
+  return failures == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Main function which runs the benchmarks selected by the command line options.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line arguments.
+ * @return 0 on success, 1 on error.
+ */
+int main(int argc, char **argv) {
+  const char *engines = NULL, *dists = NULL, *format = "table";
+  long min = 1000, max = 1000000;
+  uint64_t seed = 1;
+  bool churn = false;
+  for (int i = 1; i < argc; i++) {
+    bool valid = true; // whether the value of the option parses
+    if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+      help(argv[0]);
+      return 0;
+    } else if (strncmp(argv[i], "--engines=", 10) == 0) {
+      engines = argv[i] + 10;
+    } else if (strncmp(argv[i], "--distributions=", 16) == 0) {
+      dists = argv[i] + 16;
+    } else if (strncmp(argv[i], "--min=", 6) == 0) {
+      valid = bench_parse_long(argv[i] + 6, 1, 100000000, &min);
+    } else if (strncmp(argv[i], "--max=", 6) == 0) {
+      valid = bench_parse_long(argv[i] + 6, 1, 100000000, &max);
+    } else if (strncmp(argv[i], "--seed=", 7) == 0) {
+      valid = bench_parse_seed(argv[i] + 7, &seed);
+    } else if (strncmp(argv[i], "--format=", 9) == 0) {
+      format = argv[i] + 9;
+    } else if (strcmp(argv[i], "--churn") == 0) {
+      churn = true;
+    } else {
+      fprintf(stderr, "unknown option '%s'.\n", argv[i]);
+      help(argv[0]);
+      return 1;
+    }
+    if (!valid) {
+      fprintf(stderr, "invalid value in '%s'.\n", argv[i]);
+      help(argv[0]);
+      return 1;
+    }
+  }
+  if (max < min
+      || (strcmp(format, "table") != 0 && strcmp(format, "csv") != 0 && strcmp(format, "json") != 0)) {
+    fprintf(stderr, "invalid --min, --max or --format.\n");
+    help(argv[0]);
+    return 1;
+  }
+  if (churn)
+    return churn_main(engines, min, max, seed, format);
+
+  if (strcmp(format, "table") == 0)
+    printf("%-10s %-9s %10s %10s %7s %10s %10s %10s %12s %10s\n", "engine", "distrib", "keys", "nodes",
+           "height", "add ns", "find ns", "remove ns", "ops/s", "rss KB");
+  else if (strcmp(format, "csv") == 0)
+    printf("engine,distribution,keys,nodes,height,add_ns,find_ns,remove_ns,ops_per_s,peak_rss_kb\n");
+  else
+    printf("[");
+  int failures = 0;
+  bool first = true;
+  for (const bst_ops_t *const *engine = bst_engines(); *engine != NULL; engine++) {
+    if (!bench_in_list(engines, (*engine)->name))
+      continue;
+    for (int d = 0; distributions[d] != NULL; d++) {
+      if (!bench_in_list(dists, distributions[d]))
+        continue;
+      for (long n = min; n <= max; n *= 10) {
+        if (degenerate(*engine, distributions[d], n)) {
+          fprintf(stderr, "%s %s %ld: skipped, degenerate.\n", (*engine)->name, distributions[d], n);
+          continue;
+        }
+        bench_result_s r;
+        if (!bench_fork(*engine, distributions[d], (int)n, seed, false, &r)) {
+          fprintf(stderr, "%s %s %ld: run failed.\n", (*engine)->name, distributions[d], n);
+          failures++;
+          continue;
+        }
+        if (strcmp(format, "table") == 0)
+          printf("%-10s %-9s %10ld %10d %7d %10.1f %10.1f %10.1f %12.0f %10ld\n", (*engine)->name,
+                 distributions[d], n, r.nodes, r.height, r.add_ns, r.find_ns, r.remove_ns,
+                 r.ops_per_s, r.peak_rss_kb);
+        else if (strcmp(format, "csv") == 0)
+          printf("%s,%s,%ld,%d,%d,%.1f,%.1f,%.1f,%.0f,%ld\n", (*engine)->name, distributions[d], n,
+                 r.nodes, r.height, r.add_ns, r.find_ns, r.remove_ns, r.ops_per_s, r.peak_rss_kb);
+        else
+          printf("%s\n  {\"engine\": \"%s\", \"distribution\": \"%s\", \"keys\": %ld, \"nodes\": %d, "
+                 "\"height\": %d, \"add_ns\": %.1f, \"find_ns\": %.1f, \"remove_ns\": %.1f, "
+                 "\"ops_per_s\": %.0f, \"peak_rss_kb\": %ld}", first ? "" : ",", (*engine)->name,
+                 distributions[d], n, r.nodes, r.height, r.add_ns, r.find_ns, r.remove_ns,
+                 r.ops_per_s, r.peak_rss_kb);
+        first = false;
+      }
+    }
+  }
+  if (strcmp(format, "json") == 0)
+    printf("\n]\n");
+  return failures == 0 ? 0 : 1;
+}
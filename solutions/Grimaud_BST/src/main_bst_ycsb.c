@@ -0,0 +1,408 @@
+/**
+ * @file main_bst_ycsb.c
+ * @brief Mixed workloads, in the style of YCSB, on the binary search tree operations defined in bst.h.
+ *
+ * For every engine, this program loads a number of records into a tree, then runs a mix of reads,
+ * updates, read-modify-writes, insertions, deletions and ranges on records chosen by a request
+ * distribution. It reports the throughput over the whole run, the lowest throughput over a window of
+ * the run (the sustained one, which shows rebalancing storms) and the latency percentiles of each
+ * kind of operation.
+ *
+ * The record i has the key i with --ordered, and a scrambled key otherwise. The operations are:
+ * - read: find_node() of the key of a record;
+ * - update: remove_node() then add_node() of the key of a record, which rebalances the tree twice;
+ * - rmw (read-modify-write): a read, then an update of the same record;
+ * - insert: add_node() of the key of a new record, so that the key space grows over time;
+ * - delete: remove_node() of the key of a record, which may be read or updated again later;
+ * - range: find_node() of the keys of 1 to --range-length consecutive records, since bst.h has no
+ *   successor operation; these keys are consecutive with --ordered.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include <string.h>
+#include "bst.h"
+#include "bench.h"
+
+/**
+ * @brief Kinds of operations.
+ */
+enum { OP_READ, OP_UPDATE, OP_RMW, OP_INSERT, OP_DELETE, OP_RANGE, OP_KINDS };
+
+/**
+ * @brief Names of the kinds of operations, which are also the names of their options.
+ */
+static const char *const op_names[OP_KINDS] = {"read", "update", "rmw", "insert", "delete", "range"};
+
+/**
+ * @struct workload_s
+ * @brief A YCSB core workload: percentages of each kind of operation and request distribution.
+ */
+typedef struct workload {
+  char name;                  /**< Letter of the workload */
+  int percents[OP_KINDS];     /**< Percentage of each kind of operation */
+  const char *distribution;   /**< Request distribution */
+} workload_s;
+
+/**
+ * @brief The YCSB core workloads A to F.
+ */
+static const workload_s workloads[] = {
+  {'A', {50, 50, 0, 0, 0, 0}, "zipf"},    // update heavy
+  {'B', {95, 5, 0, 0, 0, 0}, "zipf"},     // read mostly
+  {'C', {100, 0, 0, 0, 0, 0}, "zipf"},    // read only
+  {'D', {95, 0, 0, 5, 0, 0}, "latest"},   // read latest
+  {'E', {0, 0, 0, 5, 0, 95}, "zipf"},     // short ranges
+  {'F', {50, 0, 50, 0, 0, 0}, "zipf"},    // read-modify-write
+};
+
+/**
+ * @brief Skew of the Zipfian request distributions.
+ */
+#define ZIPF_THETA 0.99
+
+/**
+ * @struct ycsb_s
+ * @brief Parameters and state of a run.
+ */
+typedef struct ycsb {
+  int percents[OP_KINDS];     /**< Percentage of each kind of operation */
+  const char *distribution;   /**< Request distribution: uniform, zipf, hotspot or latest */
+  double hot_fraction;        /**< Fraction of the records in the hot set of the hotspot distribution */
+  double hot_ops;             /**< Fraction of the operations on the hot set */
+  bool ordered;               /**< Whether the key of the record i is i */
+  int range_length;           /**< Largest number of records of a range */
+  long records;               /**< Number of records loaded before the run */
+  long operations;            /**< Number of operations of the run */
+  int windows;                /**< Number of windows of the run, for the sustained throughput */
+  uint64_t count;             /**< Number of records inserted so far */
+  zipf_s zipf;                /**< Zipfian ranks of the zipf and latest distributions */
+} ycsb_s;
+
+/**
+ * @brief Returns the key of a record.
+ *
+ * @param ycsb The run.
+ * @param record The record.
+ * @return The key.
+ */
+static int record_key(ycsb_s *ycsb, uint64_t record) {
+  return ycsb->ordered ? (int)record : bench_scramble(record);
+}
+
+/**
+ * @brief Chooses the record of an operation according to the request distribution.
+ *
+ * @param ycsb The run.
+ * @return The record, in [0, count).
+ */
+static uint64_t next_record(ycsb_s *ycsb) {
+  if (strcmp(ycsb->distribution, "zipf") == 0)
+    return (uint64_t)bench_scramble(zipf_next(&ycsb->zipf)) % ycsb->count;
+  if (strcmp(ycsb->distribution, "latest") == 0)
+    return ycsb->count - 1 - zipf_next(&ycsb->zipf);
+  if (strcmp(ycsb->distribution, "hotspot") == 0) {
+    uint64_t hot = (uint64_t)(ycsb->count * ycsb->hot_fraction);
+    if (hot < 1)
+      hot = 1;
+    if (bench_uniform() < ycsb->hot_ops || hot >= ycsb->count)
+      return bench_random() % hot;
+    return hot + bench_random() % (ycsb->count - hot);
+  }
+  return bench_random() % ycsb->count;
+}
+
+/**
+ * @brief Chooses the kind of an operation according to the percentages.
+ *
+ * @param ycsb The run.
+ * @return The kind.
+ */
+static int next_kind(ycsb_s *ycsb) {
+  int draw = bench_random() % 100;
+  for (int kind = 0; kind < OP_KINDS; kind++) {
+    if (draw < ycsb->percents[kind])
+      return kind;
+    draw -= ycsb->percents[kind];
+  }
+  return OP_READ;
+}
+
+/**
+ * @brief Compares two latencies, for qsort().
+ */
+static int compare_floats(const void *a, const void *b) {
+  float x = *(const float *)a, y = *(const float *)b;
+  return (x > y) - (x < y);
+}
+
+/**
+ * @brief Runs the workload with the current engine and prints its results.
+ *
+ * @param ycsb The run.
+ * @param seed The seed of the run.
+ * @param workload The name of the workload, printed in the results.
+ * @param csv Whether to print CSV rather than a table.
+ * @return false if the latencies could not be allocated.
+ */
+static bool ycsb_run(ycsb_s *ycsb, uint64_t seed, const char *workload, bool csv) {
+  float *latencies = malloc(ycsb->operations * sizeof(float));
+  unsigned char *kinds = malloc(ycsb->operations);
+  float *sorted = malloc(ycsb->operations * sizeof(float));
+  if (latencies == NULL || kinds == NULL || sorted == NULL) {
+    free(latencies);
+    free(kinds);
+    free(sorted);
+    return false;
+  }
+  bench_seed(seed);
+  binary_tree_s *tree = NULL;
+  for (ycsb->count = 0; ycsb->count < (uint64_t)ycsb->records; ycsb->count++)
+    tree = add_node(record_key(ycsb, ycsb->count), tree);
+  zipf_init(&ycsb->zipf, ycsb->count, ZIPF_THETA);
+
+  long window = (ycsb->operations + ycsb->windows - 1) / ycsb->windows;
+  double start = bench_now_ns(), window_start = start, min_window = 0;
+  int found = 0;
+  for (long i = 0; i < ycsb->operations; i++) {
+    int kind = next_kind(ycsb);
+    uint64_t record = (kind == OP_INSERT) ? ycsb->count : next_record(ycsb);
+    int length = (kind == OP_RANGE) ? 1 + bench_random() % ycsb->range_length : 0;
+    double before = bench_now_ns();
+    switch (kind) {
+      case OP_READ:
+        found += find_node(record_key(ycsb, record), tree);
+        break;
+      case OP_RMW:
+        found += find_node(record_key(ycsb, record), tree);
+        // fall through
+      case OP_UPDATE:
+        tree = remove_node(record_key(ycsb, record), tree);
+        tree = add_node(record_key(ycsb, record), tree);
+        break;
+      case OP_INSERT:
+        tree = add_node(record_key(ycsb, record), tree);
+        break;
+      case OP_DELETE:
+        tree = remove_node(record_key(ycsb, record), tree);
+        break;
+      case OP_RANGE:
+        for (int j = 0; j < length && record + j < ycsb->count; j++)
+          found += find_node(record_key(ycsb, record + j), tree);
+        break;
+    }
+    double after = bench_now_ns();
+    if (kind == OP_INSERT) { // the key space grows after the operation, as in YCSB
+      ycsb->count++;
+      zipf_grow(&ycsb->zipf, ycsb->count);
+    }
+    latencies[i] = after - before;
+    kinds[i] = kind;
+    if ((i + 1) % window == 0 || i + 1 == ycsb->operations) {
+      double ops_per_s = ((i % window) + 1) / (after - window_start) * 1e9;
+      if (min_window == 0 || ops_per_s < min_window)
+        min_window = ops_per_s;
+      window_start = after;
+    }
+  }
+  double ops_per_s = ycsb->operations / (bench_now_ns() - start) * 1e9;
+  int height = binary_tree_height(tree), nodes = binary_tree_nodes(tree);
+  binary_tree_free(tree);
+
+  for (int kind = -1; kind < OP_KINDS; kind++) { // -1 for all the operations
+    long n = 0;
+    double total = 0;
+    for (long i = 0; i < ycsb->operations; i++)
+      if (kind < 0 || kinds[i] == kind) {
+        sorted[n++] = latencies[i];
+        total += latencies[i];
+      }
+    if (n == 0)
+      continue;
+    qsort(sorted, n, sizeof(float), compare_floats);
+    const char *name = (kind < 0) ? "all" : op_names[kind];
+    if (csv)
+      printf("%s,%s,%s,%ld,%d,%d,%.1f,%.0f,%.0f,%.0f,%.0f,%.0f\n", bst_current()->name, workload, name,
+             n, nodes, height, total / n, sorted[n / 2], sorted[n * 99 / 100], sorted[n * 999 / 1000],
+             ops_per_s, min_window);
+    else
+      printf("%-10s %-7s %10ld %9d %7d %9.1f %9.0f %9.0f %9.0f %12.0f %12.0f\n", bst_current()->name,
+             name, n, nodes, height, total / n, sorted[n / 2], sorted[n * 99 / 100],
+             sorted[n * 999 / 1000], ops_per_s, min_window);
+  }
+  if (found < 0) // keeps the finds from being optimized away
+    printf("%d\n", found);
+  free(latencies);
+  free(kinds);
+  free(sorted);
+  return true;
+}
+
+/**
+ * @brief Displays usage information for the program.
+ */
+static void help(char *first_arg) {
+  printf("Usage: %s [options]\n", first_arg);
+  printf("Options:\n");
+  printf("  -h, --help              Show this help message and exit.\n");
+  printf("  --engines=A,B,...       Run these engines (default: all):\n");
+  printf("                         ");
+  for (const bst_ops_t *const *engine = bst_engines(); *engine != NULL; engine++)
+    printf(" %s", (*engine)->name);
+  printf("\n");
+  printf("  --workload=W            YCSB core workload A to F (default: A):\n");
+  printf("                            A: 50%% read, 50%% update, zipf\n");
+  printf("                            B: 95%% read, 5%% update, zipf\n");
+  printf("                            C: 100%% read, zipf\n");
+  printf("                            D: 95%% read, 5%% insert, latest\n");
+  printf("                            E: 95%% range, 5%% insert, zipf\n");
+  printf("                            F: 50%% read, 50%% rmw, zipf\n");
+  printf("  --read=P, --update=P, --rmw=P, --insert=P, --delete=P, --range=P\n");
+  printf("                          Percentage of each kind of operation, instead of the workload ones.\n");
+  printf("  --distribution=D        Request distribution: uniform, zipf, hotspot or latest (default: the\n");
+  printf("                          one of the workload).\n");
+  printf("  --hot=F                 Fraction of the records in the hot set of hotspot (default: 0.2).\n");
+  printf("  --hot-ops=F             Fraction of the operations on the hot set (default: 0.8).\n");
+  printf("  --ordered               Give the key i to the record i, instead of a scrambled key.\n");
+  printf("  --range-length=L        Largest number of records of a range (default: 100).\n");
+  printf("  --records=N             Records loaded before the run (default: 100000).\n");
+  printf("  --operations=N          Operations of the run (default: 1000000).\n");
+  printf("  --windows=N             Windows of the sustained throughput (default: 10).\n");
+  printf("  --seed=S                Seed of the run (default: 1).\n");
+  printf("  --format=F              Output as table or csv (default: table).\n");
+}
+
+/**
+ * @brief Main function which runs the workload selected by the command line options on each engine.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line arguments.
+ * @return 0 on success, 1 on error.
+ */
+int main(int argc, char **argv) {
+  const char *engines = NULL, *format = "table", *distribution = NULL;
+  char workload[8] = "A";
+  const workload_s *core = &workloads[0];
+  int percents[OP_KINDS];
+  bool custom = false;
+  uint64_t seed = 1;
+  ycsb_s ycsb = {.hot_fraction = 0.2, .hot_ops = 0.8, .range_length = 100, .records = 100000,
+                 .operations = 1000000, .windows = 10};
+  for (int kind = 0; kind < OP_KINDS; kind++)
+    percents[kind] = 0;
+  for (int i = 1; i < argc; i++) {
+    bool valid = true; // whether the value of the option parses
+    long number;
+    const char *value = strchr(argv[i], '=');
+    value = (value == NULL) ? "" : value + 1;
+    int kind = OP_KINDS;
+    for (int k = 0; k < OP_KINDS; k++)
+      if (strncmp(argv[i], "--", 2) == 0 && strncmp(argv[i] + 2, op_names[k], strlen(op_names[k])) == 0
+          && argv[i][2 + strlen(op_names[k])] == '=')
+        kind = k;
+    if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+      help(argv[0]);
+      return 0;
+    } else if (kind < OP_KINDS) {
+      valid = bench_parse_long(value, 0, 100, &number);
+      percents[kind] = (int)number;
+      custom = true;
+    } else if (strncmp(argv[i], "--engines=", 10) == 0) {
+      engines = value;
+    } else if (strncmp(argv[i], "--workload=", 11) == 0) {
+      core = NULL;
+      for (size_t w = 0; w < sizeof(workloads) / sizeof(workloads[0]); w++)
+        if (strlen(value) == 1 && (value[0] | 0x20) == (workloads[w].name | 0x20))
+          core = &workloads[w];
+      if (core == NULL) {
+        fprintf(stderr, "unknown workload '%s'.\n", value);
+        help(argv[0]);
+        return 1;
+      }
+    } else if (strncmp(argv[i], "--distribution=", 15) == 0) {
+      distribution = value;
+    } else if (strncmp(argv[i], "--hot=", 6) == 0) {
+      valid = bench_parse_double(value, &ycsb.hot_fraction);
+    } else if (strncmp(argv[i], "--hot-ops=", 10) == 0) {
+      valid = bench_parse_double(value, &ycsb.hot_ops);
+    } else if (strcmp(argv[i], "--ordered") == 0) {
+      ycsb.ordered = true;
+    } else if (strncmp(argv[i], "--range-length=", 15) == 0) {
+      valid = bench_parse_long(value, 1, INT_MAX, &number);
+      ycsb.range_length = (int)number;
+    } else if (strncmp(argv[i], "--records=", 10) == 0) {
+      valid = bench_parse_long(value, 1, 0x7fffffffL, &ycsb.records);
+    } else if (strncmp(argv[i], "--operations=", 13) == 0) {
+      valid = bench_parse_long(value, 1, LONG_MAX, &ycsb.operations);
+    } else if (strncmp(argv[i], "--windows=", 10) == 0) {
+      valid = bench_parse_long(value, 1, INT_MAX, &number);
+      ycsb.windows = (int)number;
+    } else if (strncmp(argv[i], "--seed=", 7) == 0) {
+      valid = bench_parse_seed(value, &seed);
+    } else if (strncmp(argv[i], "--format=", 9) == 0) {
+      format = value;
+    } else {
+      fprintf(stderr, "unknown option '%s'.\n", argv[i]);
+      help(argv[0]);
+      return 1;
+    }
+    if (!valid) {
+      fprintf(stderr, "invalid value in '%s'.\n", argv[i]);
+      help(argv[0]);
+      return 1;
+    }
+  }
+  int total = 0;
+  for (int kind = 0; kind < OP_KINDS; kind++) {
+    if (!custom)
+      percents[kind] = core->percents[kind];
+    ycsb.percents[kind] = percents[kind];
+    total += percents[kind];
+  }
+  if (custom)
+    snprintf(workload, sizeof(workload), "custom");
+  else
+    snprintf(workload, sizeof(workload), "%c", core->name);
+  ycsb.distribution = (distribution != NULL) ? distribution : core->distribution;
+  if (total != 100 || ycsb.hot_fraction <= 0 || ycsb.hot_fraction > 1 || ycsb.hot_ops < 0
+      || ycsb.hot_ops > 1
+      || (strcmp(ycsb.distribution, "uniform") != 0 && strcmp(ycsb.distribution, "zipf") != 0
+          && strcmp(ycsb.distribution, "hotspot") != 0 && strcmp(ycsb.distribution, "latest") != 0)
+      || (strcmp(format, "table") != 0 && strcmp(format, "csv") != 0)) {
+    fprintf(stderr, "invalid options: the percentages must add up to 100, the fractions be in [0, 1].\n");
+    help(argv[0]);
+    return 1;
+  }
+
+  bool csv = strcmp(format, "csv") == 0;
+  if (csv)
+    printf("engine,workload,op,count,nodes,height,mean_ns,p50_ns,p99_ns,p999_ns,ops_per_s,"
+           "min_window_ops_per_s\n");
+  else {
+    printf("Workload %s: %ld records, %ld operations, %s requests", workload, ycsb.records,
+           ycsb.operations, ycsb.distribution);
+    for (int kind = 0; kind < OP_KINDS; kind++)
+      if (percents[kind] > 0)
+        printf(", %d%% %s", percents[kind], op_names[kind]);
+    printf(".\n");
+    printf("%-10s %-7s %10s %9s %7s %9s %9s %9s %9s %12s %12s\n", "engine", "op", "count", "nodes",
+           "height", "mean ns", "p50 ns", "p99 ns", "p999 ns", "ops/s", "min ops/s");
+  }
+  for (const bst_ops_t *const *engine = bst_engines(); *engine != NULL; engine++) {
+    if (!bench_in_list(engines, (*engine)->name))
+      continue;
+    bst_use(*engine);
+    if (!ycsb_run(&ycsb, seed, workload, csv)) {
+      fprintf(stderr, "%s: not enough memory.\n", (*engine)->name);
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -3,7 +3,8 @@
  * @brief Test program for heap operations defined in heap.h.
  * 
  * This program allows testing of heap operations by taking command line arguments to
- * add numbers to a heap, print output of the heap and remove it. 
+ * add numbers to a heap, print output of the heap and remove it. With "-" as the only argument,
+ * the commands are read from the standard input and only the peeked and removed values are printed.
  *
  * @author Grimaud
  * @date 04/15/2024
@@ -28,11 +29,38 @@ int is_number(char *string) {
     return *string=='\0';
 }
 
+/**
+ * @brief Runs the commands read from the standard input, printing only the peeked and removed values.
+ *
+ * Printing the whole heap after each command, as for the commands given on the command line, would
+ * take a time quadratic in their number.
+ * @param my_heap The address of the heap, updated by the commands.
+ * @return 0 on success, 1 on an undefined command.
+ */
+static int run_stdin(heap_s **my_heap) {
+  char command[16];
+  while(scanf("%15s",command)==1) {
+    if(strcmp(command,"p")==0) {
+      printf("%d\n",heap_peek(*my_heap));
+    } else if(strcmp(command,"r")==0) {
+      printf("%d\n",heap_peek(*my_heap));
+      *my_heap=heap_remove(*my_heap);
+    } else if(is_number(command)) {
+      *my_heap=heap_add(atoi(command),*my_heap);
+    } else {
+      printf("Operation '%s' is undefined. Try -help.\n",command);
+      return 1;
+    }
+  }
+  return 0;
+}
+
 int main(int argc, char **argv) {
   heap_s *my_heap;
   if(argc==1 || strcmp(argv[1],"-help")==0) {
     printf("%s: usage\n",argv[0]);
     printf("\t%s <cmd1> <cmd2> <cmd3> ...\n",argv[0]);
+    printf("\t%s - (reads the commands from the standard input, prints the peeked and removed values)\n",argv[0]);
     printf("\twhere <cmdx> in :\n");
     printf("\t\tp      : means print the output of heap\n");
     printf("\t\tnumber : (e.g -3) means enqueue an input number in the heap\n");
@@ -43,6 +71,11 @@ int main(int argc, char **argv) {
     return 0;
   }	
   my_heap=heap_create();
+  if(argc==2 && strcmp(argv[1],"-")==0) {
+    int status=run_stdin(&my_heap);
+    heap_delete(my_heap);
+    return status;
+  }
   printf("heap_create -> ");
   heap_print(my_heap);
   printf("\n");
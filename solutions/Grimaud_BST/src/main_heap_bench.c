@@ -0,0 +1,178 @@
+/**
+ * @file main_heap_bench.c
+ * @brief Benchmark of the heap operations defined in heap.h.
+ *
+ * This program is linked with the heaps of each arity (bin/heap_bench with the binary heap,
+ * bin/heap_bench_4ary and bin/heap_bench_8ary) and with the pairing heap (bin/heap_bench_pairing).
+ * It times, on n random values, the n additions to an empty heap, the heapify of an array, the hold
+ * model (an addition then a removal on a heap of n values, n times) and the n removals which empty the
+ * heap, and reports the time per operation. Then the values are spread over SHARDS heaps, which are
+ * melded pairwise until one is left, and that heap is drained; the program fails if the values do not
+ * come out in order.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "heap.h"
+#include "bench.h"
+
+/**
+ * @brief Number of heaps melded by the meld phase.
+ */
+#define SHARDS 1024
+
+/**
+ * @brief Returns the name of the heap the program is linked with.
+ * @return "binary", "4ary", "8ary"... or "pairing".
+ */
+static const char *heap_name(void) {
+  static char name[16];
+  if (heap_arity() == 0)
+    return "pairing";
+  if (heap_arity() == 2)
+    return "binary";
+  snprintf(name, sizeof(name), "%dary", heap_arity());
+  return name;
+}
+
+/**
+ * @brief Displays usage information for the program.
+ */
+static void help(char *first_arg) {
+  printf("Usage: %s [options]\n", first_arg);
+  printf("Options:\n");
+  printf("  -h, --help    Show this help message and exit.\n");
+  printf("  --n=N         Number of values (default: 1000000).\n");
+  printf("  --seed=S      Seed of the values (default: 1).\n");
+  printf("  --format=F    Output as table or csv (default: table).\n");
+}
+
+/**
+ * @brief Prints the time per operation of a phase.
+ *
+ * @param phase The name of the phase.
+ * @param n The number of operations of the phase.
+ * @param ns The time of the phase, in nanoseconds.
+ * @param csv Whether to print CSV rather than a table.
+ */
+static void report(const char *phase, size_t n, double ns, bool csv) {
+  if (csv)
+    printf("%s,%s,%zu,%.1f\n", heap_name(), phase, n, ns / n);
+  else
+    printf("%-8s %-10s %10zu %10.1f\n", heap_name(), phase, n, ns / n);
+}
+
+/**
+ * @brief Main function which times the heap operations.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line arguments.
+ * @return 0 on success, 1 on error.
+ */
+int main(int argc, char **argv) {
+  long n = 1000000;
+  uint64_t seed = 1;
+  const char *format = "table";
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+      help(argv[0]);
+      return 0;
+    } else if (strncmp(argv[i], "--n=", 4) == 0) {
+      n = atol(argv[i] + 4);
+    } else if (strncmp(argv[i], "--seed=", 7) == 0) {
+      seed = strtoull(argv[i] + 7, NULL, 10);
+    } else if (strncmp(argv[i], "--format=", 9) == 0) {
+      format = argv[i] + 9;
+    } else {
+      fprintf(stderr, "unknown option '%s'.\n", argv[i]);
+      help(argv[0]);
+      return 1;
+    }
+  }
+  if (n < 1 || (strcmp(format, "table") != 0 && strcmp(format, "csv") != 0)) {
+    fprintf(stderr, "invalid --n or --format.\n");
+    help(argv[0]);
+    return 1;
+  }
+  bool csv = strcmp(format, "csv") == 0;
+  int *values = malloc(n * sizeof(int));
+  if (values == NULL) {
+    fprintf(stderr, "not enough memory.\n");
+    return 1;
+  }
+  bench_seed(seed);
+  for (long i = 0; i < n; i++)
+    values[i] = (int)(bench_random() >> 33);
+
+  if (csv)
+    printf("heap,phase,n,ns_per_op\n");
+  else
+    printf("%-8s %-10s %10s %10s\n", "heap", "phase", "n", "ns/op");
+  long checksum = 0;
+  double start = bench_now_ns();
+  heap_s *heap = heap_create();
+  for (long i = 0; i < n; i++)
+    heap = heap_add(values[i], heap);
+  report("add", n, bench_now_ns() - start, csv);
+  heap_delete(heap);
+
+  start = bench_now_ns();
+  heap = heap_from_array(values, n, false);
+  report("heapify", n, bench_now_ns() - start, csv);
+
+  start = bench_now_ns();
+  for (long i = 0; i < n; i++) {
+    heap = heap_add(values[i] ^ 0x5555, heap);
+    checksum += heap_peek(heap);
+    heap = heap_remove(heap);
+  }
+  report("hold", n, bench_now_ns() - start, csv);
+
+  start = bench_now_ns();
+  while (!heap_empty(heap)) {
+    checksum += heap_peek(heap);
+    heap = heap_remove(heap);
+  }
+  report("remove", n, bench_now_ns() - start, csv);
+  heap_delete(heap);
+
+  long shards = (n < SHARDS) ? n : SHARDS;
+  heap_s **heaps = malloc(shards * sizeof(heap_s *));
+  assert(heaps != NULL);
+  for (long i = 0; i < shards; i++)
+    heaps[i] = heap_create();
+  for (long i = 0; i < n; i++)
+    heaps[i % shards] = heap_add(values[i], heaps[i % shards]);
+  start = bench_now_ns();
+  for (long step = 1; step < shards; step *= 2) // pairs of heaps of the same size, as a tree
+    for (long i = 0; i + step < shards; i += 2 * step)
+      heaps[i] = heap_meld(heaps[i], heaps[i + step]);
+  report("meld", shards - 1, bench_now_ns() - start, csv);
+  heap = heaps[0];
+  free(heaps);
+
+  bool ordered = heap_size(heap) == (size_t)n;
+  start = bench_now_ns();
+  for (int previous = heap_peek(heap); !heap_empty(heap); heap = heap_remove(heap)) {
+    ordered = ordered && heap_peek(heap) <= previous;
+    previous = heap_peek(heap);
+  }
+  report("drain", n, bench_now_ns() - start, csv);
+  heap_delete(heap);
+  free(values);
+  if (!ordered) {
+    fprintf(stderr, "the melded heap does not hold the values in order.\n");
+    return 1;
+  }
+  if (checksum == 42) // keeps the peeks from being optimized away
+    printf("\n");
+  return 0;
+}
@@ -2,7 +2,10 @@
  * @file main_heapsort.c
  * @brief Implements and tests heapsort algorithm.
  * 
- * This program implements heapsort using functions in heap.h and tests it by taking command line numbers.
+ * This program sorts with heap_sort() the numbers given on the command line, or read from the
+ * standard input when there are none or the only argument is "-", which has no limit on their count.
+ * With -r first, it sorts them in descending order with a min-heap defined by heap_template.h.
+ * Without numbers on a terminal, it prints its usage rather than waiting for the standard input.
  *
  * @author Grimaud
  * @date 04/15/2024
@@ -14,49 +17,94 @@
 #include <assert.h>
 #include <string.h>
 #include <stdbool.h>
+#include <unistd.h>
 #include "heap.h"
+#include "heap_template.h"
 
-void my_heapsort(int *array, int n){
-  // Create a heap
-  heap_s *heap = heap_create();
-  // Add array element in the heap
-  for (int i = 0; i < n; i++) {
-    heap_add(array[i], heap);
-  }
-  // Get the elements in the expected order
-  for (int i = n - 1; i >= 0; i--) {
-    array[i] = heap_peek(heap); 
-    heap_remove(heap); 
+/*
+ * Binary min-heap of int: its sort puts the minimum last, hence sorts in descending order.
+ */
+HEAP_DEFINE(min_heap, int, HEAP_MIN, 2)
+
+/**
+ * @brief Displays usage information for the program.
+ */
+static void help(char *first_arg) {
+  printf("Usage: %s [-r] [num1 num2 num3 ... | -]\n", first_arg);
+  printf("Sorts the numbers in ascending order; without numbers or with -, reads them from the standard\n");
+  printf("input until its end (usage is printed instead when the standard input is a terminal).\n");
+  printf("Options:\n");
+  printf("  -h, --help    Show this help message and exit.\n");
+  printf("  -r            Sort in descending order.\n");
+}
+
+/**
+ * @brief Reads integers from a stream until its end.
+ * @param stream The stream.
+ * @param n Receives the number of integers read.
+ * @return The integers, in a growable array to free by the caller.
+ */
+static int *read_numbers(FILE *stream, size_t *n) {
+  size_t capacity = 1024;
+  int *array = malloc(capacity * sizeof(int));
+  assert(array != NULL);
+  *n = 0;
+  int value;
+  while (fscanf(stream, "%d", &value) == 1) {
+    if (*n == capacity) {
+      capacity *= 2;
+      array = realloc(array, capacity * sizeof(int));
+      assert(array != NULL);
+    }
+    array[(*n)++] = value;
   }
-  // Delete the heap
-  heap_delete(heap);
-  return;
+  return array;
 }
 
+/**
+ * @brief Main function which prints the numbers before and after sorting them.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line arguments.
+ * @return 0 on success, 1 on wrong usage.
+ */
 int main(int argc, char **argv) {
-  if (argc < 2) {
-    fprintf(stderr, "Usage: %s num1 num2 num3 ...\n", argv[0]);
+  size_t n;
+  int *array;
+  if (argc > 1 && (strcmp(argv[1], "--help") == 0 || strcmp(argv[1], "-h") == 0)) {
+    help(argv[0]);
+    return 0;
+  }
+  bool descending = argc > 1 && strcmp(argv[1], "-r") == 0;
+  int first = descending ? 2 : 1; // index of the first number
+  if (argc <= first && isatty(STDIN_FILENO)) {
+    help(argv[0]);
     return 1;
   }
-
-  int n = argc - 1;
-  int *array = (int *)malloc(n * sizeof(int));
-  assert(array != NULL);
-  
-  for (int i = 0; i < n; i++) {
-    array[i] = atoi(argv[i + 1]);
+  if (argc <= first || (argc == first + 1 && strcmp(argv[first], "-") == 0)) {
+    array = read_numbers(stdin, &n);
+  } else {
+    n = argc - first;
+    array = (int *)malloc(n * sizeof(int));
+    assert(array != NULL);
+    for (size_t i = 0; i < n; i++) {
+      array[i] = atoi(argv[i + first]);
+    }
   }
   
   printf("Before heapsort :\n");
-  for (int i = 0; i < n; i++) {
+  for (size_t i = 0; i < n; i++) {
     printf("%d ", array[i]);
   }
   printf("\n");
 
-  my_heapsort(array, n);
+  if (descending)
+    min_heap_sort(array, n);
+  else
+    heap_sort(array, n);
   
   printf("After heapsort :\n");
-  for (int i = 0; i < n; i++) {
+  for (size_t i = 0; i < n; i++) {
     printf("%d ", array[i]);
   }
   printf("\n");
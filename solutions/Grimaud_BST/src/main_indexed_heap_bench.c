@@ -0,0 +1,323 @@
+/**
+ * @file main_indexed_heap_bench.c
+ * @brief Benchmark of the indexed heap of indexed_heap.h on shortest paths and timers.
+ *
+ * The shortest paths from vertex 0 of a random graph are computed twice: with the indexed heap,
+ * which decreases the key of a vertex already in the heap, and with a min-heap of (distance, vertex)
+ * pairs from heap_template.h, which adds a duplicate instead and skips the stale pairs when they reach
+ * the top. The program checks that both give the same distances and reports their times and the
+ * largest size of their heaps. The timers workload then starts timers with random deadlines, and
+ * reschedules, cancels and expires them at random; the expired deadlines are checked to come in
+ * order.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+#include "indexed_heap.h"
+#include "heap_template.h"
+#include "bench.h"
+
+/**
+ * @brief Largest weight of an edge.
+ */
+#define MAX_WEIGHT 1000
+
+/**
+ * @brief Largest delay of a timer, short enough for the deadlines to stay far from INT_MAX.
+ */
+#define MAX_DELAY (1 << 20)
+
+/**
+ * @struct pair
+ * @brief Tentative distance of a vertex, in the heap of the lazy shortest paths.
+ */
+typedef struct pair {
+  int distance;  /**< The distance */
+  int vertex;    /**< The vertex */
+} pair_s;
+
+/**
+ * @brief Order of the pairs: the smallest distance is at the top.
+ */
+#define PAIR_BEFORE(a, b) ((a).distance < (b).distance)
+
+/*
+ * 4-ary min-heap of pairs, the arity of the indexed heap.
+ */
+HEAP_DEFINE(pair_heap, pair_s, PAIR_BEFORE, 4)
+
+/**
+ * @struct graph
+ * @brief Directed graph in compressed sparse rows: the edges of u are first[u] to first[u+1]-1.
+ */
+typedef struct graph {
+  int n;          /**< Number of vertices */
+  size_t *first;  /**< Index of the first edge of each vertex, then the number of edges */
+  int *target;    /**< Target of each edge */
+  int *weight;    /**< Weight of each edge, in [1, MAX_WEIGHT] */
+} graph_s;
+
+/**
+ * @brief Displays usage information for the program.
+ */
+static void help(char *first_arg) {
+  printf("Usage: %s [options]\n", first_arg);
+  printf("Options:\n");
+  printf("  -h, --help    Show this help message and exit.\n");
+  printf("  --vertices=N  Number of vertices of the graph (default: 1000000).\n");
+  printf("  --degree=D    Number of edges leaving each vertex (default: 8).\n");
+  printf("  --timers=N    Number of timers, and of operations on them (default: 1000000).\n");
+  printf("  --seed=S      Seed of the graph and of the timers (default: 1).\n");
+  printf("  --format=F    Output as table or csv (default: table).\n");
+}
+
+/**
+ * @brief Prints the result of a run.
+ *
+ * @param workload The name of the workload.
+ * @param heap The name of the heap.
+ * @param n The number of operations.
+ * @param ns The time of the run, in nanoseconds.
+ * @param max_size The largest size of the heap.
+ * @param csv Whether to print CSV rather than a table.
+ */
+static void report(const char *workload, const char *heap, size_t n, double ns, size_t max_size,
+                   bool csv) {
+  if (csv)
+    printf("%s,%s,%zu,%.1f,%zu\n", workload, heap, n, ns / 1e6, max_size);
+  else
+    printf("%-10s %-8s %10zu %10.1f %10zu\n", workload, heap, n, ns / 1e6, max_size);
+}
+
+/**
+ * @brief Draws a random graph, where each vertex has degree edges to random vertices.
+ * @param n The number of vertices.
+ * @param degree The number of edges leaving each vertex.
+ * @return The graph.
+ */
+static graph_s make_graph(int n, int degree) {
+  graph_s graph = { n, malloc((n + 1) * sizeof(size_t)), malloc((size_t)n * degree * sizeof(int)),
+                    malloc((size_t)n * degree * sizeof(int)) };
+  assert(graph.first != NULL && graph.target != NULL && graph.weight != NULL);
+  for (int u = 0; u <= n; u++)
+    graph.first[u] = (size_t)u * degree;
+  for (size_t e = 0; e < (size_t)n * degree; e++) {
+    graph.target[e] = bench_random() % n;
+    graph.weight[e] = 1 + bench_random() % MAX_WEIGHT;
+  }
+  return graph;
+}
+
+/**
+ * @brief Computes the distances from vertex 0 with the indexed heap (decrease-key).
+ * @param graph The graph.
+ * @param distance Receives the distance of each vertex, INT_MAX if it is not reachable.
+ * @return The largest size of the heap.
+ */
+static size_t indexed_paths(graph_s *graph, int *distance) {
+  heap_handle_t *handle = malloc(graph->n * sizeof(heap_handle_t)); // handle of each vertex in the heap
+  int *vertex = malloc(graph->n * sizeof(int)); // vertex of each handle
+  bool *done = calloc(graph->n, sizeof(bool));
+  assert(handle != NULL && vertex != NULL && done != NULL);
+  for (int u = 0; u < graph->n; u++)
+    distance[u] = INT_MAX;
+  indexed_heap_s *heap = indexed_heap_create();
+  size_t max_size = 0;
+  distance[0] = 0;
+  handle[0] = indexed_heap_add(heap, 0);
+  vertex[handle[0]] = 0;
+  while (!indexed_heap_empty(heap)) {
+    if (indexed_heap_size(heap) > max_size)
+      max_size = indexed_heap_size(heap);
+    int u = vertex[indexed_heap_remove(heap)];
+    done[u] = true;
+    for (size_t e = graph->first[u]; e < graph->first[u + 1]; e++) {
+      int v = graph->target[e];
+      int d = distance[u] + graph->weight[e];
+      if (done[v] || d >= distance[v])
+        continue;
+      if (distance[v] == INT_MAX) {
+        handle[v] = indexed_heap_add(heap, d);
+        vertex[handle[v]] = v;
+      } else {
+        indexed_heap_decrease_key(heap, handle[v], d);
+      }
+      distance[v] = d;
+    }
+  }
+  indexed_heap_delete(heap);
+  free(handle);
+  free(vertex);
+  free(done);
+  return max_size;
+}
+
+/**
+ * @brief Computes the distances from vertex 0 with duplicate pairs skipped when stale.
+ * @param graph The graph.
+ * @param distance Receives the distance of each vertex, INT_MAX if it is not reachable.
+ * @return The largest size of the heap.
+ */
+static size_t lazy_paths(graph_s *graph, int *distance) {
+  for (int u = 0; u < graph->n; u++)
+    distance[u] = INT_MAX;
+  pair_heap_s heap;
+  pair_heap_init(&heap);
+  size_t max_size = 0;
+  distance[0] = 0;
+  pair_heap_push(&heap, (pair_s){ 0, 0 });
+  while (pair_heap_size(&heap) > 0) {
+    if (pair_heap_size(&heap) > max_size)
+      max_size = pair_heap_size(&heap);
+    pair_s top = pair_heap_pop(&heap);
+    if (top.distance > distance[top.vertex]) // a stale duplicate
+      continue;
+    for (size_t e = graph->first[top.vertex]; e < graph->first[top.vertex + 1]; e++) {
+      int v = graph->target[e];
+      int d = top.distance + graph->weight[e];
+      if (d < distance[v]) {
+        distance[v] = d;
+        pair_heap_push(&heap, (pair_s){ d, v });
+      }
+    }
+  }
+  pair_heap_free(&heap);
+  return max_size;
+}
+
+/**
+ * @brief Runs the timers workload: n timers, then n random reschedules, cancellations and expiries.
+ * @param n The number of timers.
+ * @param max_size Receives the largest size of the heap.
+ * @return true if the timers expired in the order of their deadlines.
+ */
+static bool timers(size_t n, size_t *max_size) {
+  indexed_heap_s *heap = indexed_heap_create();
+  heap_handle_t *live = malloc(n * sizeof(heap_handle_t)); // handles of the live timers
+  size_t *slot = malloc(n * sizeof(size_t)); // index in live of each handle
+  assert(live != NULL && slot != NULL);
+  size_t nb_live = 0;
+  int now = 0; // deadline of the last expired timer
+  bool ordered = true;
+  for (size_t i = 0; i < n; i++) {
+    live[nb_live] = indexed_heap_add(heap, bench_random() % MAX_DELAY);
+    slot[live[nb_live]] = nb_live;
+    nb_live++;
+  }
+  *max_size = nb_live;
+  for (size_t i = 0; i < n && nb_live > 0; i++) {
+    uint64_t r = bench_random();
+    heap_handle_t handle = live[(r >> 8) % nb_live];
+    switch (r % 4) {
+      case 0: // expire
+        handle = indexed_heap_peek_handle(heap);
+        ordered = ordered && indexed_heap_peek(heap) >= now;
+        now = indexed_heap_peek(heap);
+        indexed_heap_remove(heap);
+        break;
+      case 1: // cancel
+        indexed_heap_erase(heap, handle);
+        break;
+      default: // reschedule, later or sooner but not before now
+        indexed_heap_update(heap, handle, now + (int)((r >> 32) % MAX_DELAY));
+        continue;
+    }
+    live[slot[handle]] = live[--nb_live]; // the handle leaves live
+    slot[live[slot[handle]]] = slot[handle];
+  }
+  for (; !indexed_heap_empty(heap); indexed_heap_remove(heap)) {
+    ordered = ordered && indexed_heap_peek(heap) >= now;
+    now = indexed_heap_peek(heap);
+  }
+  indexed_heap_delete(heap);
+  free(live);
+  free(slot);
+  return ordered;
+}
+
+/**
+ * @brief Main function which runs the workloads.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line arguments.
+ * @return 0 on success, 1 on error or if the results are wrong.
+ */
+int main(int argc, char **argv) {
+  long vertices = 1000000;
+  long degree = 8;
+  long nb_timers = 1000000;
+  uint64_t seed = 1;
+  const char *format = "table";
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+      help(argv[0]);
+      return 0;
+    } else if (strncmp(argv[i], "--vertices=", 11) == 0) {
+      vertices = atol(argv[i] + 11);
+    } else if (strncmp(argv[i], "--degree=", 9) == 0) {
+      degree = atol(argv[i] + 9);
+    } else if (strncmp(argv[i], "--timers=", 9) == 0) {
+      nb_timers = atol(argv[i] + 9);
+    } else if (strncmp(argv[i], "--seed=", 7) == 0) {
+      seed = strtoull(argv[i] + 7, NULL, 10);
+    } else if (strncmp(argv[i], "--format=", 9) == 0) {
+      format = argv[i] + 9;
+    } else {
+      fprintf(stderr, "unknown option '%s'.\n", argv[i]);
+      help(argv[0]);
+      return 1;
+    }
+  }
+  if (vertices < 1 || vertices > INT_MAX / MAX_WEIGHT || degree < 1 || nb_timers < 1
+      || (strcmp(format, "table") != 0 && strcmp(format, "csv") != 0)) {
+    fprintf(stderr, "invalid --vertices, --degree, --timers or --format.\n");
+    help(argv[0]);
+    return 1;
+  }
+  bool csv = strcmp(format, "csv") == 0;
+  bench_seed(seed);
+  graph_s graph = make_graph(vertices, degree);
+  int *indexed_distance = malloc(vertices * sizeof(int));
+  int *lazy_distance = malloc(vertices * sizeof(int));
+  assert(indexed_distance != NULL && lazy_distance != NULL);
+
+  if (csv)
+    printf("workload,heap,n,ms,max_size\n");
+  else
+    printf("%-10s %-8s %10s %10s %10s\n", "workload", "heap", "n", "ms", "max_size");
+  size_t edges = graph.first[vertices];
+  double start = bench_now_ns();
+  size_t max_size = indexed_paths(&graph, indexed_distance);
+  report("dijkstra", "indexed", edges, bench_now_ns() - start, max_size, csv);
+  start = bench_now_ns();
+  max_size = lazy_paths(&graph, lazy_distance);
+  report("dijkstra", "lazy", edges, bench_now_ns() - start, max_size, csv);
+  int status = 0;
+  if (memcmp(indexed_distance, lazy_distance, vertices * sizeof(int)) != 0) {
+    fprintf(stderr, "the shortest paths of the indexed and lazy heaps differ.\n");
+    status = 1;
+  }
+
+  start = bench_now_ns();
+  bool ordered = timers(nb_timers, &max_size);
+  report("timers", "indexed", nb_timers, bench_now_ns() - start, max_size, csv);
+  if (!ordered) {
+    fprintf(stderr, "the timers did not expire in order.\n");
+    status = 1;
+  }
+  free(indexed_distance);
+  free(lazy_distance);
+  free(graph.first);
+  free(graph.target);
+  free(graph.weight);
+  return status;
+}
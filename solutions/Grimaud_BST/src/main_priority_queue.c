@@ -3,7 +3,9 @@
  * @brief Test program for priority queue operations defined in queue.h.
  * 
  * This program allows testing of priority queue operations by taking command line arguments to
- * add numbers to a priority queue, print the output of queue and remove it. 
+ * add numbers to a priority queue, print the output of queue and remove it. With "-" as the only
+ * argument, the commands are read from the standard input and only the peeked and removed values are
+ * printed.
  *
  * @author Grimaud
  * @date 04/15/2024
@@ -28,11 +30,38 @@ int is_number(char *string) {
     return *string=='\0';
 }
 
+/**
+ * @brief Runs the commands read from the standard input, printing only the peeked and removed values.
+ *
+ * Printing the whole queue after each command, as for the commands given on the command line, would
+ * take a time quadratic in their number.
+ * @param my_queue The address of the queue, updated by the commands.
+ * @return 0 on success, 1 on an undefined command.
+ */
+static int run_stdin(queue_s **my_queue) {
+  char command[16];
+  while(scanf("%15s",command)==1) {
+    if(strcmp(command,"p")==0) {
+      printf("%d\n",queue_peek(*my_queue));
+    } else if(strcmp(command,"r")==0) {
+      printf("%d\n",queue_peek(*my_queue));
+      *my_queue=queue_dequeue(*my_queue);
+    } else if(is_number(command)) {
+      *my_queue=queue_enqueue(atoi(command),*my_queue);
+    } else {
+      printf("Operation '%s' is undefined. Try -help.\n",command);
+      return 1;
+    }
+  }
+  return 0;
+}
+
 int main(int argc, char **argv) {
     queue_s *my_queue;
     if(argc==1 || strcmp(argv[1],"-help")==0) {
       printf("%s: usage\n",argv[0]);
       printf("\t%s <cmd1> <cmd2> <cmd3> ...\n",argv[0]);
+      printf("\t%s - (reads the commands from the standard input, prints the peeked and removed values)\n",argv[0]);
       printf("\twhere <cmdx> in :\n");
       printf("\t\tp      : means print the output of queue\n");
       printf("\t\tnumber : (e.g -3) means enqueue an input number in the queue\n");
@@ -43,6 +72,11 @@ int main(int argc, char **argv) {
       return 0;
     }	
     my_queue=queue_create();
+    if(argc==2 && strcmp(argv[1],"-")==0) {
+      int status=run_stdin(&my_queue);
+      queue_delete(my_queue);
+      return status;
+    }
     printf("queue_create    -> ");
     queue_print(my_queue);
     printf("\n");
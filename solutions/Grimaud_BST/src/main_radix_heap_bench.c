@@ -0,0 +1,183 @@
+/**
+ * @file main_radix_heap_bench.c
+ * @brief Benchmark of the radix heap of radix_heap.h against comparison heaps on an event queue.
+ *
+ * The event queue of a simulation holds n events; each operation removes the next event and
+ * schedules a new one after a random delay, so the removed times never decrease. The same events are
+ * run with the radix heap and with binary and 4-ary min-heaps from heap_template.h; the program
+ * checks that they remove the same times and reports the time per operation.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "radix_heap.h"
+#include "heap_template.h"
+#include "bench.h"
+
+/*
+ * Binary and 4-ary min-heaps of times, the comparison heaps.
+ */
+HEAP_DEFINE(binary_heap, uint64_t, HEAP_MIN, 2)
+HEAP_DEFINE(quad_heap, uint64_t, HEAP_MIN, 4)
+
+/**
+ * @brief Displays usage information for the program.
+ */
+static void help(char *first_arg) {
+  printf("Usage: %s [options]\n", first_arg);
+  printf("Options:\n");
+  printf("  -h, --help        Show this help message and exit.\n");
+  printf("  --n=N             Number of pending events (default: 1000000).\n");
+  printf("  --operations=N    Number of events run (default: 10000000).\n");
+  printf("  --max-delay=D     Largest delay of a new event (default: 1048576).\n");
+  printf("  --seed=S          Seed of the delays (default: 1).\n");
+  printf("  --format=F        Output as table or csv (default: table).\n");
+}
+
+/**
+ * @brief Prints the time per operation of a heap.
+ *
+ * @param heap The name of the heap.
+ * @param n The number of pending events.
+ * @param operations The number of operations.
+ * @param ns The time of the operations, in nanoseconds.
+ * @param csv Whether to print CSV rather than a table.
+ */
+static void report(const char *heap, long n, long operations, double ns, bool csv) {
+  if (csv)
+    printf("%s,%ld,%ld,%.1f\n", heap, n, operations, ns / operations);
+  else
+    printf("%-8s %10ld %12ld %10.1f\n", heap, n, operations, ns / operations);
+}
+
+/*
+ * Each run draws the same delays from the seed and returns the sum of the removed times, after
+ * reporting the time of its operations.
+ */
+
+/**
+ * @brief Runs the event queue with the radix heap.
+ * @return The sum of the removed times.
+ */
+static uint64_t run_radix(long n, long operations, uint64_t max_delay, uint64_t seed, bool csv) {
+  bench_seed(seed);
+  radix_heap_s *heap = radix_heap_create();
+  for (long i = 0; i < n; i++)
+    radix_heap_add(bench_random() % max_delay, heap);
+  uint64_t sum = 0;
+  double start = bench_now_ns();
+  for (long i = 0; i < operations; i++) {
+    uint64_t now = radix_heap_peek(heap);
+    radix_heap_remove(heap);
+    sum += now;
+    radix_heap_add(now + bench_random() % max_delay, heap);
+  }
+  report("radix", n, operations, bench_now_ns() - start, csv);
+  radix_heap_delete(heap);
+  return sum;
+}
+
+/**
+ * @brief Runs the event queue with the binary min-heap.
+ * @return The sum of the removed times.
+ */
+static uint64_t run_binary(long n, long operations, uint64_t max_delay, uint64_t seed, bool csv) {
+  bench_seed(seed);
+  binary_heap_s heap;
+  binary_heap_init(&heap);
+  for (long i = 0; i < n; i++)
+    binary_heap_push(&heap, bench_random() % max_delay);
+  uint64_t sum = 0;
+  double start = bench_now_ns();
+  for (long i = 0; i < operations; i++) {
+    uint64_t now = binary_heap_pop(&heap);
+    sum += now;
+    binary_heap_push(&heap, now + bench_random() % max_delay);
+  }
+  report("binary", n, operations, bench_now_ns() - start, csv);
+  binary_heap_free(&heap);
+  return sum;
+}
+
+/**
+ * @brief Runs the event queue with the 4-ary min-heap.
+ * @return The sum of the removed times.
+ */
+static uint64_t run_quad(long n, long operations, uint64_t max_delay, uint64_t seed, bool csv) {
+  bench_seed(seed);
+  quad_heap_s heap;
+  quad_heap_init(&heap);
+  for (long i = 0; i < n; i++)
+    quad_heap_push(&heap, bench_random() % max_delay);
+  uint64_t sum = 0;
+  double start = bench_now_ns();
+  for (long i = 0; i < operations; i++) {
+    uint64_t now = quad_heap_pop(&heap);
+    sum += now;
+    quad_heap_push(&heap, now + bench_random() % max_delay);
+  }
+  report("4ary", n, operations, bench_now_ns() - start, csv);
+  quad_heap_free(&heap);
+  return sum;
+}
+
+/**
+ * @brief Main function which times the heaps.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line arguments.
+ * @return 0 on success, 1 on error or if the heaps disagree.
+ */
+int main(int argc, char **argv) {
+  long n = 1000000;
+  long operations = 10000000;
+  uint64_t max_delay = 1 << 20;
+  uint64_t seed = 1;
+  const char *format = "table";
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+      help(argv[0]);
+      return 0;
+    } else if (strncmp(argv[i], "--n=", 4) == 0) {
+      n = atol(argv[i] + 4);
+    } else if (strncmp(argv[i], "--operations=", 13) == 0) {
+      operations = atol(argv[i] + 13);
+    } else if (strncmp(argv[i], "--max-delay=", 12) == 0) {
+      max_delay = strtoull(argv[i] + 12, NULL, 10);
+    } else if (strncmp(argv[i], "--seed=", 7) == 0) {
+      seed = strtoull(argv[i] + 7, NULL, 10);
+    } else if (strncmp(argv[i], "--format=", 9) == 0) {
+      format = argv[i] + 9;
+    } else {
+      fprintf(stderr, "unknown option '%s'.\n", argv[i]);
+      help(argv[0]);
+      return 1;
+    }
+  }
+  if (n < 1 || operations < 1 || max_delay < 1
+      || (strcmp(format, "table") != 0 && strcmp(format, "csv") != 0)) {
+    fprintf(stderr, "invalid --n, --operations, --max-delay or --format.\n");
+    help(argv[0]);
+    return 1;
+  }
+  bool csv = strcmp(format, "csv") == 0;
+  if (csv)
+    printf("heap,n,operations,ns_per_op\n");
+  else
+    printf("%-8s %10s %12s %10s\n", "heap", "n", "operations", "ns/op");
+  uint64_t radix = run_radix(n, operations, max_delay, seed, csv);
+  uint64_t binary = run_binary(n, operations, max_delay, seed, csv);
+  uint64_t quad = run_quad(n, operations, max_delay, seed, csv);
+  if (radix != binary || radix != quad) {
+    fprintf(stderr, "the heaps removed different times.\n");
+    return 1;
+  }
+  return 0;
+}
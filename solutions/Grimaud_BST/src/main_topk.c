@@ -0,0 +1,172 @@
+/**
+ * @file main_topk.c
+ * @brief Prints the k largest (or smallest) integers of a file or of the standard input.
+ *
+ * The integers, separated by any non-digit characters, are parsed from large reads and pushed by
+ * batches into a top-k of topk.h, so that the stream is never stored, however long it is.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <assert.h>
+#include "topk.h"
+
+/**
+ * @brief Size of the reads of the input, in bytes.
+ */
+#define READ_SIZE (1 << 16)
+
+/**
+ * @brief Number of integers pushed at once into the top-k.
+ */
+#define BATCH_SIZE 4096
+
+/**
+ * @brief Magnitude beyond which the digits of an integer are ignored, well beyond the range of int.
+ */
+#define MAX_MAGNITUDE 100000000000LL
+
+/**
+ * @brief Displays usage information for the program.
+ */
+static void help(char *first_arg) {
+  printf("Usage: %s [options] [FILE]\n", first_arg);
+  printf("Prints the k largest integers of FILE, or of the standard input without FILE or with -.\n");
+  printf("An integer out of the range of int is an error: nothing is printed and the exit status is 1.\n");
+  printf("Options:\n");
+  printf("  -h, --help    Show this help message and exit.\n");
+  printf("  --k=K         Number of integers to print (default: 10).\n");
+  printf("  --smallest    Print the k smallest integers instead, in ascending order.\n");
+}
+
+/**
+ * @brief Checks that an integer parsed by push_stream() fits in an int, with an error message if not.
+ * @param value The magnitude of the integer.
+ * @param negative Whether the integer has a '-'.
+ * @return true if the integer is in the range of int.
+ */
+static bool in_range(long long value, bool negative) {
+  if (negative ? -value >= INT_MIN : value <= INT_MAX)
+    return true;
+  fprintf(stderr, "integer out of the range of int [%d, %d].\n", INT_MIN, INT_MAX);
+  return false;
+}
+
+/**
+ * @brief Pushes all the integers of a stream into a top-k.
+ *
+ * An integer is an optional '-' followed by digits; an integer split between two reads is carried
+ * over to the next one.
+ * @param stream The stream.
+ * @param topk The top-k.
+ * @return false if an integer is out of the range of int, after an error message; true otherwise.
+ */
+static bool push_stream(FILE *stream, topk_t *topk) {
+  static char buffer[READ_SIZE];
+  int batch[BATCH_SIZE];
+  size_t nb_batch = 0;
+  bool in_number = false; // whether digits of an integer were read
+  bool negative = false;  // whether the current integer (or the next one) has a '-'
+  long long value = 0;
+  size_t length;
+  while ((length = fread(buffer, 1, READ_SIZE, stream)) > 0) {
+    for (size_t i = 0; i < length; i++) {
+      char c = buffer[i];
+      if (c >= '0' && c <= '9') {
+        if (value < MAX_MAGNITUDE) // longer integers are out of the range of int anyway
+          value = value * 10 + (c - '0');
+        in_number = true;
+        continue;
+      }
+      if (in_number) {
+        if (!in_range(value, negative))
+          return false;
+        batch[nb_batch++] = (int)(negative ? -value : value);
+        if (nb_batch == BATCH_SIZE) {
+          topk_push_batch(topk, batch, nb_batch);
+          nb_batch = 0;
+        }
+        in_number = false;
+        value = 0;
+      }
+      negative = c == '-';
+    }
+  }
+  if (in_number) {
+    if (!in_range(value, negative))
+      return false;
+    batch[nb_batch++] = (int)(negative ? -value : value);
+  }
+  topk_push_batch(topk, batch, nb_batch);
+  return true;
+}
+
+/**
+ * @brief Main function which prints the top-k of the input, one integer per line.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line arguments.
+ * @return 0 on success, 1 on error.
+ */
+int main(int argc, char **argv) {
+  long k = 10;
+  bool largest = true;
+  const char *file = NULL;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+      help(argv[0]);
+      return 0;
+    } else if (strncmp(argv[i], "--k=", 4) == 0) {
+      char *end;
+      errno = 0;
+      k = strtol(argv[i] + 4, &end, 10);
+      if (end == argv[i] + 4 || *end != '\0' || errno != 0)
+        k = -1; // rejected below
+    } else if (strcmp(argv[i], "--smallest") == 0) {
+      largest = false;
+    } else if (file == NULL && (argv[i][0] != '-' || strcmp(argv[i], "-") == 0)) {
+      file = argv[i];
+    } else {
+      fprintf(stderr, "unknown option '%s'.\n", argv[i]);
+      help(argv[0]);
+      return 1;
+    }
+  }
+  if (k < 0) {
+    fprintf(stderr, "invalid --k.\n");
+    help(argv[0]);
+    return 1;
+  }
+  FILE *stream = stdin;
+  if (file != NULL && strcmp(file, "-") != 0) {
+    stream = fopen(file, "r");
+    if (stream == NULL) {
+      perror(file);
+      return 1;
+    }
+  }
+  topk_t *topk = topk_create(k, largest);
+  bool ok = push_stream(stream, topk);
+  if (stream != stdin)
+    fclose(stream);
+  if (!ok) {
+    topk_delete(topk);
+    return 1;
+  }
+  int *result = malloc((k > 0 ? k : 1) * sizeof(int));
+  assert(result != NULL);
+  size_t n = topk_result(topk, result);
+  for (size_t i = 0; i < n; i++)
+    printf("%d\n", result[i]);
+  free(result);
+  topk_delete(topk);
+  return 0;
+}
@@ -0,0 +1,321 @@
+/**
+ * @file pairing_heap.c
+ * @brief Pairing heap implementation of heap.h, meldable in O(1).
+ *
+ * The heap is a tree where each node is not lower than its children, stored as first child and next
+ * sibling pointers. An addition and a meld link two roots: the lower one becomes the first child of
+ * the other, in O(1). Removing the root pairs its children from left to right, then links the pairs
+ * from right to left (the two-pass variant), in amortized O(log n).
+ *
+ * The nodes come from a pool owned by the heap: blocks of nodes, each as large as all the previous
+ * ones together, whose free nodes are kept in a list. Melding two heaps joins their blocks and their
+ * free lists, so that the nodes of both heaps are freed together by heap_delete().
+ *
+ * heap_sort() does not need a tree and sorts the array in place with the binary heap of
+ * heap_template.h.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "heap.h"
+#include "heap_template.h"
+
+/**
+ * @brief Number of nodes of the first block of a heap created without a hint.
+ */
+#define POOL_MIN_BLOCK 16
+
+/*
+ * Binary max-heap of int, used by heap_sort().
+ */
+HEAP_DEFINE(array_heap, int, HEAP_MAX, 2)
+
+/**
+ * @struct node
+ * @brief Node of the pairing heap, or free node of the pool.
+ */
+typedef struct node {
+  int value;             /**< The value */
+  struct node *child;    /**< First child, NULL for a leaf */
+  struct node *sibling;  /**< Next sibling, or next free node in the pool */
+} node_s;
+
+/**
+ * @struct block
+ * @brief Block of nodes of the pool.
+ */
+typedef struct block {
+  struct block *next;  /**< Next block of the pool */
+  node_s nodes[];      /**< The nodes */
+} block_s;
+
+/**
+ * @struct heap
+ * @brief Structure of the heap.
+ */
+typedef struct heap {
+  node_s *root;         /**< The root, NULL for an empty heap */
+  size_t nb_elements;   /**< Number of elements */
+  size_t capacity;      /**< Number of nodes of the pool */
+  block_s *blocks;      /**< The blocks of the pool */
+  block_s *last_block;  /**< The last block, to join pools in O(1) */
+  node_s *free_nodes;   /**< The free nodes, linked by their sibling field */
+  node_s *last_free;    /**< The last free node, to join pools in O(1) */
+} heap_s;
+
+/**
+ * @brief Adds a block of nodes to the pool of a heap, all of them free.
+ * @param heap The heap.
+ * @param size The number of nodes of the block, at least 1.
+ */
+static void pool_grow(heap_s *heap, size_t size) {
+  block_s *block = malloc(sizeof(block_s) + size * sizeof(node_s));
+  assert(block != NULL);
+  block->next = heap->blocks;
+  if (heap->blocks == NULL)
+    heap->last_block = block;
+  heap->blocks = block;
+  for (size_t i = 0; i + 1 < size; i++)
+    block->nodes[i].sibling = &block->nodes[i + 1];
+  block->nodes[size - 1].sibling = heap->free_nodes;
+  if (heap->free_nodes == NULL)
+    heap->last_free = &block->nodes[size - 1];
+  heap->free_nodes = &block->nodes[0];
+  heap->capacity += size;
+}
+
+/**
+ * @brief Takes a node from the pool of a heap, which grows if it has no free node.
+ * @param heap The heap.
+ * @param value The value of the node.
+ * @return The node, without child nor sibling.
+ */
+static node_s *pool_alloc(heap_s *heap, int value) {
+  if (heap->free_nodes == NULL)
+    pool_grow(heap, (heap->capacity == 0) ? POOL_MIN_BLOCK : heap->capacity);
+  node_s *node = heap->free_nodes;
+  heap->free_nodes = node->sibling;
+  if (heap->free_nodes == NULL)
+    heap->last_free = NULL;
+  node->value = value;
+  node->child = NULL;
+  node->sibling = NULL;
+  return node;
+}
+
+/**
+ * @brief Gives a node back to the pool of a heap.
+ * @param heap The heap.
+ * @param node The node.
+ */
+static void pool_free(heap_s *heap, node_s *node) {
+  node->sibling = heap->free_nodes;
+  if (heap->free_nodes == NULL)
+    heap->last_free = node;
+  heap->free_nodes = node;
+}
+
+/**
+ * @brief Links two roots: the lower one becomes the first child of the other.
+ * @param a A root, without sibling.
+ * @param b Another root, without sibling.
+ * @return The root of the linked tree.
+ */
+static inline node_s *link(node_s *a, node_s *b) {
+  if (b->value > a->value) {
+    node_s *tmp = a;
+    a = b;
+    b = tmp;
+  }
+  b->sibling = a->child;
+  a->child = b;
+  return a;
+}
+
+/**
+ * @brief Links a list of sibling trees into one tree (two-pass pairing).
+ * @param first The first tree of the list, or NULL.
+ * @return The root of the tree, without sibling, or NULL for an empty list.
+ */
+static node_s *merge_pairs(node_s *first) {
+  node_s *pairs = NULL; // the linked pairs, in reverse order
+  while (first != NULL) {
+    node_s *a = first;
+    node_s *b = a->sibling;
+    if (b == NULL) {
+      a->sibling = pairs;
+      pairs = a;
+      break;
+    }
+    first = b->sibling;
+    a->sibling = NULL;
+    b->sibling = NULL;
+    node_s *pair = link(a, b);
+    pair->sibling = pairs;
+    pairs = pair;
+  }
+  node_s *root = NULL;
+  while (pairs != NULL) { // from the last pair back to the first one
+    node_s *next = pairs->sibling;
+    pairs->sibling = NULL;
+    root = (root == NULL) ? pairs : link(root, pairs);
+    pairs = next;
+  }
+  return root;
+}
+
+/*
+ * The functions of heap.h are documented in the header.
+ */
+
+heap_s *heap_create() {
+  return heap_create_with_capacity(0);
+}
+
+heap_s *heap_create_with_capacity(size_t capacity) {
+  heap_s *res = malloc(sizeof(heap_s));
+  assert(res != NULL);
+  res->root = NULL;
+  res->nb_elements = 0;
+  res->capacity = 0;
+  res->blocks = NULL;
+  res->last_block = NULL;
+  res->free_nodes = NULL;
+  res->last_free = NULL;
+  if (capacity > 0)
+    pool_grow(res, capacity);
+  return res;
+}
+
+heap_s *heap_from_array(int *array, size_t n, bool take_ownership) {
+  assert(array != NULL || n == 0);
+  heap_s *res = heap_create_with_capacity(n);
+  for (size_t i = 0; i < n; i++)
+    heap_add(array[i], res);
+  if (take_ownership)
+    free(array);
+  return res;
+}
+
+void heap_sort(int *array, size_t n) {
+  assert(array != NULL || n == 0);
+  array_heap_sort(array, n);
+}
+
+heap_s *heap_shrink_to_fit(heap_s *heap) {
+  assert(heap != NULL);
+  if (heap->nb_elements == 0) { // the blocks hold live nodes otherwise
+    while (heap->blocks != NULL) {
+      block_s *next = heap->blocks->next;
+      free(heap->blocks);
+      heap->blocks = next;
+    }
+    heap->last_block = NULL;
+    heap->free_nodes = NULL;
+    heap->last_free = NULL;
+    heap->capacity = 0;
+  }
+  return heap;
+}
+
+size_t heap_size(heap_s *heap) {
+  assert(heap != NULL);
+  return heap->nb_elements;
+}
+
+size_t heap_capacity(heap_s *heap) {
+  assert(heap != NULL);
+  return heap->capacity;
+}
+
+heap_s *heap_add(int value, heap_s *heap) {
+  assert(heap != NULL);
+  node_s *node = pool_alloc(heap, value);
+  heap->root = (heap->root == NULL) ? node : link(heap->root, node);
+  heap->nb_elements++;
+  return heap;
+}
+
+int heap_arity(void) {
+  return 0;
+}
+
+bool heap_empty(heap_s *heap) {
+  assert(heap != NULL);
+  return heap->nb_elements == 0;
+}
+
+int heap_peek(heap_s *heap) {
+  assert(!heap_empty(heap));
+  return heap->root->value;
+}
+
+heap_s *heap_remove(heap_s *heap) {
+  assert(!heap_empty(heap));
+  node_s *root = heap->root;
+  heap->root = merge_pairs(root->child);
+  pool_free(heap, root);
+  heap->nb_elements--;
+  return heap;
+}
+
+heap_s *heap_meld(heap_s *heap, heap_s *other) {
+  assert(heap != NULL && other != NULL);
+  if (other->root != NULL)
+    heap->root = (heap->root == NULL) ? other->root : link(heap->root, other->root);
+  heap->nb_elements += other->nb_elements;
+  heap->capacity += other->capacity;
+  if (other->blocks != NULL) { // the blocks of other go after those of heap
+    if (heap->blocks == NULL)
+      heap->blocks = other->blocks;
+    else
+      heap->last_block->next = other->blocks;
+    heap->last_block = other->last_block;
+  }
+  if (other->free_nodes != NULL) {
+    if (heap->free_nodes == NULL)
+      heap->free_nodes = other->free_nodes;
+    else
+      heap->last_free->sibling = other->free_nodes;
+    heap->last_free = other->last_free;
+  }
+  free(other);
+  return heap;
+}
+
+void heap_print(heap_s *heap) {
+  assert(heap != NULL);
+  printf("heap:");
+  // preorder walk with an explicit stack: the tree can be as deep as it has nodes
+  node_s **stack = malloc((heap->nb_elements + 1) * sizeof(node_s *));
+  assert(stack != NULL);
+  size_t top = 0;
+  if (heap->root != NULL)
+    stack[top++] = heap->root;
+  while (top > 0) {
+    node_s *node = stack[--top];
+    printf(" %d", node->value);
+    if (node->sibling != NULL && node != heap->root)
+      stack[top++] = node->sibling;
+    if (node->child != NULL)
+      stack[top++] = node->child;
+  }
+  printf("\n");
+  free(stack);
+}
+
+void heap_delete(heap_s *heap) {
+  assert(heap != NULL);
+  while (heap->blocks != NULL) {
+    block_s *next = heap->blocks->next;
+    free(heap->blocks);
+    heap->blocks = next;
+  }
+  free(heap);
+}
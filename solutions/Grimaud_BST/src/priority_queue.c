@@ -54,14 +54,15 @@ queue_s *queue_enqueue(int value, queue_s *queue) {
 /**
  * @brief Tests if the priority queue is empty or not.
  *
- * Tests if the priority queue is empty or not.
+ * Tests if the priority queue is empty or not, in O(1): every engine represents the empty tree by
+ * NULL, so the nodes are not counted (peek and dequeue test it on each call).
  * @param queue Address of the current queue.
  * @return true if the queue is empty, false otherwise.
  * @note Asserts if the queue is created.
  */
 bool queue_empty(queue_s *queue) {
   assert(queue != NULL);
-  return binary_tree_nodes(queue->inner_bst) == 0;
+  return queue->inner_bst == NULL;
 }
 
 /**
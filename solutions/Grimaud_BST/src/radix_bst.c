@@ -0,0 +1,710 @@
+/**
+ * @file radix_bst.c
+ * @brief Implementation of the binary search tree operations in C using an adaptive radix tree.
+ *
+ * This file contains an implementation of the ordered set operations of bst.h on an adaptive radix tree
+ * (Leis, Kemper and Neumann) over the four bytes of the values. The value is first mapped to an unsigned
+ * key whose bytes, from the most significant one, are in the same order as the values. Each level of the
+ * tree consumes one byte, so a search costs at most four steps and never compares whole values, and an
+ * in-order traversal is a walk of the children in the order of the bytes.
+ *
+ * The inner nodes adapt their size to their number of children (4, 16, 48 or 256) to keep a low memory
+ * per value on both sparse and dense sets. A subtree holding a single value is not expanded : the value is
+ * stored directly in the child slot of its parent (lazy expansion), so the values need no allocation.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "bst.h"
+
+/**
+ * @brief Number of bytes of a key, i.e. maximal depth of the tree.
+ */
+#define KEY_BYTES 4
+
+/**
+ * @enum node_type_e
+ * @brief Enumerates the sizes of the inner nodes.
+ */
+enum node_type_e {
+  NODE4,   /**< Up to 4 children, sorted bytes and children arrays. */
+  NODE16,  /**< Up to 16 children, sorted bytes and children arrays. */
+  NODE48,  /**< Up to 48 children, a 256 entries index to the children array. */
+  NODE256  /**< Up to 256 children, directly indexed by the byte. */
+};
+
+/**
+ * @brief A child slot : 0 when empty, a tagged value (lowest bit set) for a leaf, or a pointer to an inner node.
+ */
+typedef uintptr_t slot_t;
+
+_Static_assert(sizeof(slot_t) >= 8, "a leaf stores a 32 bits key shifted by one bit in a slot");
+
+/**
+ * @struct art_node_s
+ * @brief Header shared by all the inner nodes.
+ */
+typedef struct art_node {
+  uint8_t type;                      /**< The size of the node (node_type_e) */
+  uint16_t count;                    /**< The number of children */
+} art_node_s;
+
+/**
+ * @struct node4_s
+ * @brief Inner node with up to 4 children.
+ */
+typedef struct {
+  art_node_s header;                 /**< The common header */
+  uint8_t keys[4];                   /**< The bytes of the children, sorted */
+  slot_t children[4];                /**< The children, in the order of keys */
+} node4_s;
+
+/**
+ * @struct node16_s
+ * @brief Inner node with up to 16 children.
+ */
+typedef struct {
+  art_node_s header;                 /**< The common header */
+  uint8_t keys[16];                  /**< The bytes of the children, sorted */
+  slot_t children[16];               /**< The children, in the order of keys */
+} node16_s;
+
+/**
+ * @struct node48_s
+ * @brief Inner node with up to 48 children.
+ */
+typedef struct {
+  art_node_s header;                 /**< The common header */
+  uint8_t index[256];                /**< For each byte, 0 if there is no child, else its position plus one */
+  slot_t children[48];               /**< The children, in any order */
+} node48_s;
+
+/**
+ * @struct node256_s
+ * @brief Inner node with up to 256 children.
+ */
+typedef struct {
+  art_node_s header;                 /**< The common header */
+  slot_t children[256];              /**< The child of each byte */
+} node256_s;
+
+/**
+ * @struct binary_tree_s
+ * @brief A structure to represent an adaptive radix tree.
+ *
+ * An empty tree is represented by NULL.
+ */
+typedef struct binary_tree {
+  slot_t root;                       /**< The root slot */
+  int size;                          /**< The number of values in the tree */
+} binary_tree_s;
+
+/**
+ * @brief Maps a value to a key whose unsigned order is the order of the values.
+ */
+static inline uint32_t to_key(int value) {
+  return (uint32_t)value ^ 0x80000000u;
+}
+
+/**
+ * @brief Maps a key back to its value.
+ */
+static inline int to_value(uint32_t key) {
+  return (int)(key ^ 0x80000000u);
+}
+
+/**
+ * @brief Returns the byte of a key used at a given depth, from the most significant one.
+ */
+static inline uint8_t key_byte(uint32_t key, int depth) {
+  return (key >> (8 * (KEY_BYTES - 1 - depth))) & 0xff;
+}
+
+/**
+ * @brief Tests if a non empty slot holds a leaf.
+ */
+static inline bool is_leaf(slot_t slot) {
+  return slot & 1;
+}
+
+/**
+ * @brief Builds the leaf slot of a key.
+ */
+static inline slot_t make_leaf(uint32_t key) {
+  return ((slot_t)key << 1) | 1;
+}
+
+/**
+ * @brief Returns the key stored in a leaf slot.
+ */
+static inline uint32_t leaf_key(slot_t slot) {
+  return (uint32_t)(slot >> 1);
+}
+
+/**
+ * @brief Allocates an empty inner node.
+ *
+ * @param type The size of the node.
+ * @return The new node.
+ */
+static art_node_s *node_create(enum node_type_e type) {
+  static const size_t sizes[] = { sizeof(node4_s), sizeof(node16_s), sizeof(node48_s), sizeof(node256_s) };
+  art_node_s *node = calloc(1, sizes[type]);
+  assert(node != NULL);
+  node->type = type;
+  return node;
+}
+
+/**
+ * @brief Finds the slot of the child of a node for a given byte.
+ *
+ * @param node The inner node.
+ * @param byte The byte of the child.
+ * @return The address of the child slot, NULL if there is no such child.
+ */
+static slot_t *find_child(art_node_s *node, uint8_t byte) {
+  switch (node->type) {
+  case NODE4: {
+    node4_s *n = (node4_s *)node;
+    for (int i = 0; i < node->count; i++)
+      if (n->keys[i] == byte)
+        return &n->children[i];
+    return NULL;
+  }
+  case NODE16: {
+    node16_s *n = (node16_s *)node;
+    for (int i = 0; i < node->count; i++)
+      if (n->keys[i] == byte)
+        return &n->children[i];
+    return NULL;
+  }
+  case NODE48: {
+    node48_s *n = (node48_s *)node;
+    return n->index[byte] ? &n->children[n->index[byte] - 1] : NULL;
+  }
+  default: {
+    node256_s *n = (node256_s *)node;
+    return n->children[byte] ? &n->children[byte] : NULL;
+  }
+  }
+}
+
+/**
+ * @brief Returns the children of a node in the order of their bytes.
+ *
+ * @param node The inner node.
+ * @param children Output : the children, at least node->count slots.
+ * @param bytes Output : the bytes of the children (may be NULL).
+ * @return The number of children.
+ */
+static int node_children(art_node_s *node, slot_t *children, uint8_t *bytes) {
+  int count = 0;
+  switch (node->type) {
+  case NODE4:
+  case NODE16: {
+    uint8_t *keys = (node->type == NODE4) ? ((node4_s *)node)->keys : ((node16_s *)node)->keys;
+    slot_t *slots = (node->type == NODE4) ? ((node4_s *)node)->children : ((node16_s *)node)->children;
+    for (; count < node->count; count++) {
+      children[count] = slots[count];
+      if (bytes != NULL)
+        bytes[count] = keys[count];
+    }
+    break;
+  }
+  case NODE48: {
+    node48_s *n = (node48_s *)node;
+    for (int b = 0; b < 256; b++)
+      if (n->index[b]) {
+        children[count] = n->children[n->index[b] - 1];
+        if (bytes != NULL)
+          bytes[count] = b;
+        count++;
+      }
+    break;
+  }
+  default: {
+    node256_s *n = (node256_s *)node;
+    for (int b = 0; b < 256; b++)
+      if (n->children[b]) {
+        children[count] = n->children[b];
+        if (bytes != NULL)
+          bytes[count] = b;
+        count++;
+      }
+  }
+  }
+  return count;
+}
+
+/**
+ * @brief Builds a node of another size holding the children of a node, and frees the old one.
+ *
+ * @param node The inner node to resize.
+ * @param type The size of the new node, large enough for all the children.
+ * @return The new node.
+ */
+static art_node_s *node_resize(art_node_s *node, enum node_type_e type) {
+  slot_t children[256];
+  uint8_t bytes[256];
+  int count = node_children(node, children, bytes);
+  art_node_s *res = node_create(type);
+  res->count = count;
+  for (int i = 0; i < count; i++) {
+    switch (type) {
+    case NODE4:
+      ((node4_s *)res)->keys[i] = bytes[i];
+      ((node4_s *)res)->children[i] = children[i];
+      break;
+    case NODE16:
+      ((node16_s *)res)->keys[i] = bytes[i];
+      ((node16_s *)res)->children[i] = children[i];
+      break;
+    case NODE48:
+      ((node48_s *)res)->index[bytes[i]] = i + 1;
+      ((node48_s *)res)->children[i] = children[i];
+      break;
+    default:
+      ((node256_s *)res)->children[bytes[i]] = children[i];
+    }
+  }
+  free(node);
+  return res;
+}
+
+/**
+ * @brief Adds a child to a node, growing the node when it is full.
+ *
+ * @param ref The slot holding the node, updated if the node is replaced by a larger one.
+ * @param byte The byte of the new child, not already used in the node.
+ * @param child The new child.
+ */
+static void add_child(slot_t *ref, uint8_t byte, slot_t child) {
+  art_node_s *node = (art_node_s *)*ref;
+  static const int capacity[] = { 4, 16, 48, 256 };
+  if (node->count == capacity[node->type]) {
+    node = node_resize(node, node->type + 1);
+    *ref = (slot_t)node;
+  }
+  switch (node->type) {
+  case NODE4:
+  case NODE16: {
+    uint8_t *keys = (node->type == NODE4) ? ((node4_s *)node)->keys : ((node16_s *)node)->keys;
+    slot_t *slots = (node->type == NODE4) ? ((node4_s *)node)->children : ((node16_s *)node)->children;
+    int i = node->count;
+    while (i > 0 && keys[i - 1] > byte) { // keep the bytes sorted
+      keys[i] = keys[i - 1];
+      slots[i] = slots[i - 1];
+      i--;
+    }
+    keys[i] = byte;
+    slots[i] = child;
+    break;
+  }
+  case NODE48: {
+    node48_s *n = (node48_s *)node;
+    int i = 0;
+    while (n->children[i] != 0)
+      i++;
+    n->children[i] = child;
+    n->index[byte] = i + 1;
+    break;
+  }
+  default:
+    ((node256_s *)node)->children[byte] = child;
+  }
+  node->count++;
+}
+
+/**
+ * @brief Removes the child of a node for a given byte, shrinking the node when it becomes sparse.
+ *
+ * @param ref The slot holding the node, updated if the node is replaced by a smaller one.
+ * @param byte The byte of the child to remove.
+ */
+static void remove_child(slot_t *ref, uint8_t byte) {
+  art_node_s *node = (art_node_s *)*ref;
+  switch (node->type) {
+  case NODE4:
+  case NODE16: {
+    uint8_t *keys = (node->type == NODE4) ? ((node4_s *)node)->keys : ((node16_s *)node)->keys;
+    slot_t *slots = (node->type == NODE4) ? ((node4_s *)node)->children : ((node16_s *)node)->children;
+    int i = 0;
+    while (keys[i] != byte)
+      i++;
+    memmove(&keys[i], &keys[i + 1], (node->count - i - 1) * sizeof(uint8_t));
+    memmove(&slots[i], &slots[i + 1], (node->count - i - 1) * sizeof(slot_t));
+    break;
+  }
+  case NODE48: {
+    node48_s *n = (node48_s *)node;
+    n->children[n->index[byte] - 1] = 0;
+    n->index[byte] = 0;
+    break;
+  }
+  default:
+    ((node256_s *)node)->children[byte] = 0;
+  }
+  node->count--;
+  // Shrink with some hysteresis so that a node does not oscillate between two sizes
+  if (node->type == NODE256 && node->count <= 40)
+    *ref = (slot_t)node_resize(node, NODE48);
+  else if (node->type == NODE48 && node->count <= 12)
+    *ref = (slot_t)node_resize(node, NODE16);
+  else if (node->type == NODE16 && node->count <= 3)
+    *ref = (slot_t)node_resize(node, NODE4);
+}
+
+/**
+ * @brief Computes the height of a subtree, a leaf having the height 0.
+ *
+ * @param slot The root slot of the subtree, not empty.
+ * @return The height of the subtree.
+ */
+static int slot_height(slot_t slot) {
+  if (is_leaf(slot))
+    return 0;
+  slot_t children[256];
+  int count = node_children((art_node_s *)slot, children, NULL);
+  int height = 0;
+  for (int i = 0; i < count; i++) {
+    int h = slot_height(children[i]);
+    if (h > height)
+      height = h;
+  }
+  return height + 1;
+}
+
+/**
+ * @brief Calculates the height of the radix tree, i.e. its number of inner levels on the longest path.
+ *
+ * @param tree The radix tree.
+ * @return The height of the tree (at most 4). Returns -1 if the tree is empty.
+ */
+static int radix_binary_tree_height(binary_tree_s *tree) {
+  if (tree == NULL)
+    return -1;
+  return slot_height(tree->root);
+}
+
+/**
+ * @brief Counts the number of values in the radix tree.
+ *
+ * @param tree The radix tree.
+ * @return The number of values. Returns 0 if the tree is empty.
+ */
+static int radix_binary_tree_nodes(binary_tree_s *tree) {
+  if (tree == NULL)
+    return 0;
+  return tree->size;
+}
+
+/**
+ * @brief Internal helper function to print the radix tree.
+ *
+ * Each inner node is printed with its size, and each child with its byte in hexadecimal.
+ *
+ * @param slot The slot being printed.
+ * @param prefix The current prefix for aligning the printed output.
+ */
+static void print_slot(slot_t slot, char *prefix) {
+  static const char *names[] = { "N4", "N16", "N48", "N256" };
+  if (is_leaf(slot)) {
+    printf("(%04d)\n", to_value(leaf_key(slot)));
+    return;
+  }
+  art_node_s *node = (art_node_s *)slot;
+  slot_t children[256];
+  uint8_t bytes[256];
+  char new_prefix[200]; // Buffer limited to 200 bytes (<200 characters)
+  int count = node_children(node, children, bytes);
+  printf("[%s]\n", names[node->type]);
+  for (int i = 0; i < count; i++) {
+    bool last = (i == count - 1);
+    printf("%s%s%02x─", prefix, last ? "└" : "├", bytes[i]);
+    snprintf(new_prefix, sizeof(new_prefix), "%s%s    ", prefix, last ? " " : "│");
+    print_slot(children[i], new_prefix);
+  }
+}
+
+/**
+ * @brief Public function to print the entire radix tree.
+ *
+ * This function displays the tree's height and number of values before printing the tree structure.
+ *
+ * @param tree The radix tree to be printed.
+ */
+static void radix_binary_tree_print(binary_tree_s *tree) {
+  int height = radix_binary_tree_height(tree);
+  int nodes = radix_binary_tree_nodes(tree);
+  printf("height : %d  - nodes : %d\n", height, nodes);
+  if (height >= 0)
+    print_slot(tree->root, "");
+  else
+    printf("Empty binary tree.\n");
+  return;
+}
+
+/**
+ * @brief Find the minimum value in the radix tree.
+ *
+ * @param tree The radix tree, which must not be empty.
+ * @return the minimum value, i.e. the value reached through the smallest bytes.
+ */
+static int radix_min_value_node(binary_tree_s *tree) {
+  assert(tree != NULL);
+  slot_t slot = tree->root;
+  slot_t children[256];
+  while (!is_leaf(slot)) {
+    node_children((art_node_s *)slot, children, NULL);
+    slot = children[0];
+  }
+  return to_value(leaf_key(slot));
+}
+
+/**
+ * @brief Inserts a key in a subtree.
+ *
+ * @param ref The root slot of the subtree.
+ * @param key The key to insert.
+ * @param depth The depth of the subtree, i.e. the index of the byte used to choose its child.
+ * @return true if the key was added, false if it was already present.
+ */
+static bool insert(slot_t *ref, uint32_t key, int depth) {
+  if (*ref == 0) {
+    *ref = make_leaf(key);
+    return true;
+  }
+  if (is_leaf(*ref)) {
+    uint32_t other = leaf_key(*ref);
+    if (other == key)
+      return false;
+    // Expand the leaf into a node holding it, the bytes are compared again at this depth
+    slot_t leaf = *ref;
+    *ref = (slot_t)node_create(NODE4);
+    add_child(ref, key_byte(other, depth), leaf);
+  }
+  slot_t *child = find_child((art_node_s *)*ref, key_byte(key, depth));
+  if (child != NULL)
+    return insert(child, key, depth + 1);
+  add_child(ref, key_byte(key, depth), make_leaf(key));
+  return true;
+}
+
+/**
+ * @brief Adds a value to the radix tree.
+ *
+ * If the value already exists in the tree, the tree is returned unchanged.
+ *
+ * @param value The value to be added.
+ * @param tree The radix tree (can be NULL if the tree is empty).
+ * @return The modified radix tree.
+ */
+static binary_tree_s *radix_add_node(int value, binary_tree_s *tree) {
+  if (tree == NULL) {
+    tree = malloc(sizeof(binary_tree_s));
+    assert(tree != NULL);
+    tree->root = 0;
+    tree->size = 0;
+  }
+  if (insert(&tree->root, to_key(value), 0))
+    tree->size++;
+  return tree;
+}
+
+/**
+ * @brief Checks whether a value exists in the radix tree.
+ *
+ * The search follows one byte of the key per level and compares the whole key only once, in the leaf.
+ *
+ * @param value The value to search for.
+ * @param tree The radix tree.
+ * @return true if the value is found, false otherwise.
+ */
+static bool radix_find_node(int value, binary_tree_s *tree) {
+  if (tree == NULL)
+    return false;
+  uint32_t key = to_key(value);
+  slot_t slot = tree->root;
+  for (int depth = 0; !is_leaf(slot); depth++) {
+    slot_t *child = find_child((art_node_s *)slot, key_byte(key, depth));
+    if (child == NULL)
+      return false;
+    slot = *child;
+  }
+  return leaf_key(slot) == key;
+}
+
+/**
+ * @brief Prints the values of a subtree in a sorted order.
+ *
+ * @param slot The root slot of the subtree.
+ * @param ascending Specifies the order of the output: true for ascending, false for descending.
+ */
+static void dump_slot(slot_t slot, bool ascending) {
+  if (is_leaf(slot)) {
+    printf("%d ", to_value(leaf_key(slot)));
+    return;
+  }
+  slot_t children[256];
+  int count = node_children((art_node_s *)slot, children, NULL);
+  for (int i = 0; i < count; i++)
+    dump_slot(children[ascending ? i : count - 1 - i], ascending);
+}
+
+/**
+ * @brief Prints all values in the radix tree in a sorted order.
+ *
+ * The values are displayed in ascending order if `ascending` is true, and in descending order if
+ * `ascending` is false.
+ *
+ * @param tree The radix tree to be dumped.
+ * @param ascending Specifies the order of the output: true for ascending, false for descending.
+ */
+static void radix_dump_tree(binary_tree_s *tree, bool ascending) {
+  if (tree != NULL)
+    dump_slot(tree->root, ascending);
+  return;
+}
+
+/**
+ * @brief Copies the values of a subtree in ascending order into an array.
+ *
+ * @param slot The root slot of the subtree.
+ * @param array The array receiving the values.
+ * @return The number of values copied.
+ */
+static int slot_to_array(slot_t slot, int *array) {
+  if (is_leaf(slot)) {
+    array[0] = to_value(leaf_key(slot));
+    return 1;
+  }
+  slot_t children[256];
+  int count = node_children((art_node_s *)slot, children, NULL);
+  int n = 0;
+  for (int i = 0; i < count; i++)
+    n += slot_to_array(children[i], array + n);
+  return n;
+}
+
+/**
+ * @brief Copies all values of the radix tree in ascending order into an array.
+ *
+ * @param tree The radix tree.
+ * @param array The array receiving the values, large enough for all the values of the tree.
+ * @return The number of values copied.
+ */
+static int radix_binary_tree_to_array(binary_tree_s *tree, int *array) {
+  if (tree == NULL)
+    return 0;
+  return slot_to_array(tree->root, array);
+}
+
+/**
+ * @brief Removes a key from a subtree.
+ *
+ * An inner node left with a single leaf is replaced by this leaf, which undoes the lazy expansion.
+ *
+ * @param ref The root slot of the subtree.
+ * @param key The key to remove.
+ * @param depth The depth of the subtree.
+ * @return true if the key was removed, false if it was not present.
+ */
+static bool erase(slot_t *ref, uint32_t key, int depth) {
+  if (*ref == 0)
+    return false;
+  if (is_leaf(*ref)) {
+    if (leaf_key(*ref) != key)
+      return false;
+    *ref = 0;
+    return true;
+  }
+  uint8_t byte = key_byte(key, depth);
+  slot_t *child = find_child((art_node_s *)*ref, byte);
+  if (child == NULL || !erase(child, key, depth + 1))
+    return false;
+  if (*child == 0)
+    remove_child(ref, byte);
+  art_node_s *node = (art_node_s *)*ref;
+  if (node->count == 1) {
+    slot_t last;
+    node_children(node, &last, NULL);
+    if (is_leaf(last)) {
+      free(node);
+      *ref = last;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Removes a value from the radix tree if it exists.
+ *
+ * @param value The value to be removed.
+ * @param tree The radix tree.
+ * @return The modified radix tree; NULL if the tree is empty after removal.
+ */
+static binary_tree_s *radix_remove_node(int value, binary_tree_s *tree) {
+  if (tree == NULL)
+    return NULL;
+  if (erase(&tree->root, to_key(value), 0))
+    tree->size--;
+  if (tree->size == 0) {
+    free(tree);
+    return NULL;
+  }
+  return tree;
+}
+
+/**
+ * @brief Frees the inner nodes of a subtree.
+ *
+ * @param slot The root slot of the subtree.
+ */
+static void free_slot(slot_t slot) {
+  if (slot == 0 || is_leaf(slot))
+    return;
+  slot_t children[256];
+  int count = node_children((art_node_s *)slot, children, NULL);
+  for (int i = 0; i < count; i++)
+    free_slot(children[i]);
+  free((art_node_s *)slot);
+}
+
+/**
+ * @brief Frees the memory occupied by a radix tree.
+ *
+ * It safely handles trees that are NULL by terminating early.
+ *
+ * @param tree Pointer to the radix tree to be freed.
+ */
+static void radix_binary_tree_free(binary_tree_s *tree) {
+  if (tree == NULL)
+    return;
+  free_slot(tree->root);
+  free(tree);
+}
+
+/**
+ * @brief Operations of the adaptive radix tree engine.
+ */
+const bst_ops_t radix_bst_ops = {
+  .name = "radix",
+  .add_node = radix_add_node,
+  .find_node = radix_find_node,
+  .remove_node = radix_remove_node,
+  .binary_tree_height = radix_binary_tree_height,
+  .binary_tree_nodes = radix_binary_tree_nodes,
+  .min_value_node = radix_min_value_node,
+  .dump_tree = radix_dump_tree,
+  .binary_tree_to_array = radix_binary_tree_to_array,
+  .binary_tree_print = radix_binary_tree_print,
+  .binary_tree_free = radix_binary_tree_free,
+};
@@ -0,0 +1,150 @@
+/**
+ * @file radix_heap.c
+ * @brief Implementation of the radix heap of radix_heap.h.
+ *
+ * Bucket 0 holds the keys equal to the last key removed (or peeked), and bucket b > 0 the keys whose
+ * highest bit differing from it is bit b-1. A key only moves to lower buckets: when bucket 0 is
+ * empty, the smallest key of the first non-empty bucket becomes the last key, and the keys of that
+ * bucket, which share all their bits above b-1 with it, spread over the buckets below b. Each key
+ * moves at most 64 times, hence O(log C) amortized per removal.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "radix_heap.h"
+
+/**
+ * @brief Number of buckets: one for the keys equal to the last key removed, one per bit.
+ */
+#define NB_BUCKETS 65
+
+/**
+ * @brief Capacity of the array allocated by the first key of a bucket.
+ */
+#define BUCKET_MIN_CAPACITY 16
+
+/**
+ * @struct bucket
+ * @brief Keys of a bucket, in no order.
+ */
+typedef struct bucket {
+  uint64_t *keys;   /**< The keys, NULL while the capacity is 0 */
+  size_t size;      /**< Number of keys */
+  size_t capacity;  /**< Number of keys the array can hold */
+} bucket_s;
+
+/**
+ * @struct radix_heap
+ * @brief Structure of the radix heap.
+ */
+typedef struct radix_heap {
+  uint64_t last;                 /**< The last key removed or peeked */
+  size_t nb_elements;            /**< Number of keys */
+  bucket_s buckets[NB_BUCKETS];  /**< The buckets */
+} radix_heap_s;
+
+/**
+ * @brief Returns the bucket of a key.
+ * @param key The key.
+ * @param last The last key removed or peeked, not greater than the key.
+ * @return 0 if the key equals last, otherwise 1 + the index of the highest bit where they differ.
+ */
+static inline int bucket_of(uint64_t key, uint64_t last) {
+  return (key == last) ? 0 : 64 - __builtin_clzll(key ^ last);
+}
+
+/**
+ * @brief Appends a key to a bucket, which grows as needed.
+ * @param bucket The bucket.
+ * @param key The key.
+ */
+static inline void bucket_push(bucket_s *bucket, uint64_t key) {
+  if (bucket->size == bucket->capacity) {
+    bucket->capacity = (bucket->capacity == 0) ? BUCKET_MIN_CAPACITY : 2 * bucket->capacity;
+    bucket->keys = realloc(bucket->keys, bucket->capacity * sizeof(uint64_t));
+    assert(bucket->keys != NULL);
+  }
+  bucket->keys[bucket->size++] = key;
+}
+
+/**
+ * @brief Fills bucket 0 if it is empty, from the first non-empty bucket.
+ * @param heap The heap, not empty.
+ */
+static void refill(radix_heap_s *heap) {
+  if (heap->buckets[0].size > 0)
+    return;
+  int b = 1;
+  while (heap->buckets[b].size == 0)
+    b++;
+  bucket_s *bucket = &heap->buckets[b];
+  uint64_t min = bucket->keys[0];
+  for (size_t i = 1; i < bucket->size; i++)
+    if (bucket->keys[i] < min)
+      min = bucket->keys[i];
+  heap->last = min;
+  for (size_t i = 0; i < bucket->size; i++) // every key goes below b
+    bucket_push(&heap->buckets[bucket_of(bucket->keys[i], min)], bucket->keys[i]);
+  bucket->size = 0;
+}
+
+/*
+ * The functions of radix_heap.h are documented in the header.
+ */
+
+radix_heap_s *radix_heap_create(void) {
+  radix_heap_s *res = malloc(sizeof(radix_heap_s));
+  assert(res != NULL);
+  res->last = 0;
+  res->nb_elements = 0;
+  for (int b = 0; b < NB_BUCKETS; b++) {
+    res->buckets[b].keys = NULL;
+    res->buckets[b].size = 0;
+    res->buckets[b].capacity = 0;
+  }
+  return res;
+}
+
+size_t radix_heap_size(radix_heap_s *heap) {
+  assert(heap != NULL);
+  return heap->nb_elements;
+}
+
+bool radix_heap_empty(radix_heap_s *heap) {
+  assert(heap != NULL);
+  return heap->nb_elements == 0;
+}
+
+radix_heap_s *radix_heap_add(uint64_t key, radix_heap_s *heap) {
+  assert(heap != NULL && key >= heap->last);
+  bucket_push(&heap->buckets[bucket_of(key, heap->last)], key);
+  heap->nb_elements++;
+  return heap;
+}
+
+uint64_t radix_heap_peek(radix_heap_s *heap) {
+  assert(!radix_heap_empty(heap));
+  refill(heap);
+  return heap->last;
+}
+
+radix_heap_s *radix_heap_remove(radix_heap_s *heap) {
+  assert(!radix_heap_empty(heap));
+  refill(heap);
+  heap->buckets[0].size--; // all the keys of bucket 0 are equal
+  heap->nb_elements--;
+  return heap;
+}
+
+void radix_heap_delete(radix_heap_s *heap) {
+  assert(heap != NULL);
+  for (int b = 0; b < NB_BUCKETS; b++)
+    free(heap->buckets[b].keys);
+  free(heap);
+}
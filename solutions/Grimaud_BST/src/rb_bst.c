@@ -60,12 +60,12 @@ typedef struct binary_tree {
  * @param tree The root of the binary tree.
  * @return The height of the tree. Returns 0 if the tree is empty.
  */
-int binary_tree_height(binary_tree_s *tree) {
+static int rb_binary_tree_height(binary_tree_s *tree) {
   if(tree==NULL)
     return -1;
   else {
-    int left  = binary_tree_height(tree->left);
-    int right = binary_tree_height(tree->right);
+    int left  = rb_binary_tree_height(tree->left);
+    int right = rb_binary_tree_height(tree->right);
     int max = (left > right) ? left : right;
     return max + 1;
   } 
@@ -79,11 +79,11 @@ int binary_tree_height(binary_tree_s *tree) {
  * @param tree The root of the binary tree.
  * @return The total number of nodes in the tree. Returns 0 if the tree is empty.
  */
-int binary_tree_nodes(binary_tree_s *tree) {
+static int rb_binary_tree_nodes(binary_tree_s *tree) {
   if(tree==NULL)
     return 0;
   else 
-    return binary_tree_nodes(tree->left) + binary_tree_nodes(tree->right) + 1;
+    return rb_binary_tree_nodes(tree->left) + rb_binary_tree_nodes(tree->right) + 1;
 }
 
 /**
@@ -98,7 +98,7 @@ int binary_tree_nodes(binary_tree_s *tree) {
  * @param is_left Flag indicating if the current node is a left child.
  * @param prefix The current prefix for aligning the printed output.
  */
-void binary_tree_print_aux(binary_tree_s *node, int depth, int height, int is_left, char *prefix) {
+static void binary_tree_print_aux(binary_tree_s *node, int depth, int height, int is_left, char *prefix) {
   char new_prefix[200]; // Buffer limited to 200 bytes (<200 characters)
   if (node == NULL) return;
   // print right
@@ -134,12 +134,12 @@ void binary_tree_print_aux(binary_tree_s *node, int depth, int height, int is_le
  * 
  * @param tree The root of the binary tree to be printed.
  */
-void binary_tree_print(binary_tree_s *tree) {
-  int height = binary_tree_height(tree);
-  int nodes = binary_tree_nodes(tree);
+static void rb_binary_tree_print(binary_tree_s *tree) {
+  int height = rb_binary_tree_height(tree);
+  int nodes = rb_binary_tree_nodes(tree);
   printf("height : %d  - nodes : %d\n", height, nodes);
-  if (binary_tree_height(tree)>=0) 
-    binary_tree_print_aux(tree, 0, binary_tree_height(tree), 0, "");
+  if (rb_binary_tree_height(tree)>=0) 
+    binary_tree_print_aux(tree, 0, rb_binary_tree_height(tree), 0, "");
   else
     printf("Empty binary tree.\n");
   return;
@@ -154,10 +154,11 @@ void binary_tree_print(binary_tree_s *tree) {
  * @param node The root node of the subtree.
  * @return Node with the minimum value in the given subtree.
  */
-int min_value_node(binary_tree_s *node) {
+static int rb_min_value_node(binary_tree_s *node) {
     assert(node!=NULL) ;
+    BST_COUNT(visits);
     if(node->left!=NULL)
-      return min_value_node(node->left);
+      return rb_min_value_node(node->left);
     return node->value;
 }
 
@@ -171,10 +172,11 @@ int min_value_node(binary_tree_s *node) {
  * @param tree The root of the binary tree to rotate.
  * @return The new root of the subtree after rotation.
  */
-binary_tree_s *bst_rotate_left(binary_tree_s *tree) {
+static binary_tree_s *bst_rotate_left(binary_tree_s *tree) {
   if (tree == NULL || tree->right == NULL) {
     return tree;  // No rotation needed if tree is NULL or has no right child
   }
+  BST_COUNT(rotations);
   binary_tree_s *new_root = tree->right;
   tree->right = new_root->left;
   new_root->left = tree;
@@ -191,10 +193,11 @@ binary_tree_s *bst_rotate_left(binary_tree_s *tree) {
  * @param tree The root of the binary tree to rotate.
  * @return The new root of the subtree after rotation.
  */
-binary_tree_s *bst_rotate_right(binary_tree_s *tree) {
+static binary_tree_s *bst_rotate_right(binary_tree_s *tree) {
   if (tree == NULL || tree->left == NULL) {
     return tree;  // No rotation needed if tree is NULL or has no left child
   }
+  BST_COUNT(rotations);
   binary_tree_s *new_root = tree->left;
   tree->left = new_root->right;
   new_root->right = tree;
@@ -221,22 +224,26 @@ binary_tree_s *bst_rotate_right(binary_tree_s *tree) {
  *
  * @return The new root node of the sub-tree after potential rotations and color adjustments.
  */
-binary_tree_s *fix_red_black(binary_tree_s *root) {
+static binary_tree_s *fix_red_black(binary_tree_s *root) {
   if(root->left != NULL && root->left->color == RED && root->left->left != NULL && root->left->left->color == RED){
     root->left->left->color = BLACK;
+    BST_COUNT(recolorings);
     return bst_rotate_right(root);
   }
   if(root->left != NULL && root->left->color == RED && root->left->right != NULL && root->left->right->color == RED){
     root->left->color = BLACK;
+    BST_COUNT(recolorings);
     root->left = bst_rotate_left(root->left);
     return bst_rotate_right(root);  
   }
   if(root->right != NULL && root->right->color == RED && root->right->right != NULL && root->right->right->color == RED){
     root->right->right->color = BLACK;
+    BST_COUNT(recolorings);
     return bst_rotate_left(root);
   }
   if(root->right != NULL && root->right->color == RED && root->right->left != NULL && root->right->left->color == RED){
     root->right->color = BLACK;
+    BST_COUNT(recolorings);
     root->right = bst_rotate_right(root->right);
     return bst_rotate_left(root);
   }
@@ -263,19 +270,21 @@ binary_tree_s *fix_red_black(binary_tree_s *root) {
  *
  * @return The root of the subtree after the insertion, potentially adjusted by `fix_red_black`.
  */
-binary_tree_s *add_node_rec(int value, binary_tree_s *root) {
+static binary_tree_s *add_node_rec(int value, binary_tree_s *root) {
   if (root == NULL) {
     binary_tree_s *node = malloc(sizeof(binary_tree_s));
     assert(node != NULL);
+    BST_COUNT(allocations);
     node->value = value;
     node->left = node->right = NULL;
     node->color = RED;
     return node;
   }
-  if (value < root->value) {
+  BST_COUNT(visits);
+  if (BST_COMPARE(value < root->value)) {
     root->left = add_node_rec(value, root->left);
     root = fix_red_black(root);
-  } else if (value > root->value) {
+  } else if (BST_COMPARE(value > root->value)) {
     root->right = add_node_rec(value, root->right);
     root = fix_red_black(root);
   }
@@ -300,8 +309,10 @@ binary_tree_s *add_node_rec(int value, binary_tree_s *root) {
  *
  * @return The root of the red-black tree after the insertion. This root is guaranteed to be black.
  */
-binary_tree_s *add_node(int value, binary_tree_s *root) {
+static binary_tree_s *rb_add_node(int value, binary_tree_s *root) {
   root = add_node_rec(value, root);
+  if (root->color == RED)
+    BST_COUNT(recolorings);
   root->color = BLACK; 
   return root;
 }
@@ -316,14 +327,15 @@ binary_tree_s *add_node(int value, binary_tree_s *root) {
  * @param tree The root of the binary tree.
  * @return true if the value is found, false otherwise.
  */
-bool find_node(int value, binary_tree_s *tree) {
+static bool rb_find_node(int value, binary_tree_s *tree) {
   if(tree==NULL)
     return false;
-  if(tree->value==value)
+  BST_COUNT(visits);
+  if(BST_COMPARE(tree->value==value))
     return true;
-  if(tree->value < value) 
-    return find_node(value, tree->right);
-  return find_node(value, tree->left);
+  if(BST_COMPARE(tree->value < value))
+    return rb_find_node(value, tree->right);
+  return rb_find_node(value, tree->left);
 }
 
 /**
@@ -337,240 +349,204 @@ bool find_node(int value, binary_tree_s *tree) {
  * @param tree The root node of the binary tree to be dumped.
  * @param ascending Specifies the order of the output: true for ascending, false for descending.
  */
-void dump_tree(binary_tree_s *tree, bool ascending) {
+static void rb_dump_tree(binary_tree_s *tree, bool ascending) {
   if(tree != NULL){
     if(ascending){
       // Ascending to boolean
       if (tree->left != NULL)
-	dump_tree(tree->left,ascending);
+	rb_dump_tree(tree->left,ascending);
       printf("%d ",tree->value);
       if (tree->right != NULL)
-	dump_tree(tree->right,ascending);
+	rb_dump_tree(tree->right,ascending);
     } else {
       if (tree->right != NULL)
-	dump_tree(tree->right,ascending);
+	rb_dump_tree(tree->right,ascending);
       printf("%d ",tree->value);     
       if (tree->left != NULL)
-	dump_tree(tree->left,ascending);
+	rb_dump_tree(tree->left,ascending);
     }
   }
   return;
 }   
 
 /**
- * @brief Finds the parent of a node with a specified value in the binary tree.
+ * @brief Copies all values of the binary search tree in ascending order into an array.
  *
- * This function searches for the parent of the node with the specified value.
- * If the node with the given value is found, it returns the parent node. If the node
- * is not found or is the root (and thus has no parent), it returns NULL.
+ * @param tree The root node of the binary tree.
+ * @param array The array receiving the values, large enough for all the values of the tree.
+ * @return The number of values copied.
+ */
+static int rb_binary_tree_to_array(binary_tree_s *tree, int *array) {
+  if(tree==NULL)
+    return 0;
+  int n = rb_binary_tree_to_array(tree->left, array);
+  array[n++] = tree->value;
+  return n + rb_binary_tree_to_array(tree->right, array + n);
+}
+
+/**
+ * @brief Restores the black height of a node whose left subtree lost a black node in a removal.
  *
- * @param value The integer value of the node whose parent is to be found.
- * @param root The root of the tree or subtree to be searched.
+ * The right subtree, one black node higher, is not empty. A red sibling is first rotated above the
+ * node, which then has a black sibling. A black sibling with a red child gives it to the left side
+ * by one or two rotations, which restores the black height. A black sibling with black children
+ * turns red, so that the right subtree loses a black node too: the node makes up for it if it is
+ * red, by turning black, and passes the loss to its parent otherwise.
  *
- * @return The parent node of the node with the specified value, or NULL if not found or if the node is the root.
+ * @param root The node whose left subtree lost a black node.
+ * @param shorter Set to true if the subtree of the node still has one black node less.
+ * @return The new root of the subtree.
  */
-binary_tree_s *find_parent(int value, binary_tree_s *root) {
-    if (root == NULL || root->left == NULL && root->right == NULL) {
-        // Tree is empty or root has no children, so no parent exists
-        return NULL;
-    }
-    // Check if the current node is the parent of the node with the given value
-    if ((root->left != NULL && root->left->value == value) ||
-        (root->right != NULL && root->right->value == value)) {
-        return root;
-    }
-    // Recur to the left subtree if the value is less than
-    // the current node's value
-    if (value < root->value) {
-        return find_parent(value, root->left);
-    }
-    // Recur to the right subtree if the value is greater than
-    // the current node's value
-    if (value > root->value) {
-        return find_parent(value, root->right);
+static binary_tree_s *fix_left_shorter(binary_tree_s *root, bool *shorter) {
+  binary_tree_s *sibling = root->right;
+  if (sibling->color == RED) {
+    // The node is black: rotate the sibling above it, the node becomes red with a black sibling
+    sibling->color = BLACK;
+    root->color = RED;
+    BST_ADD(recolorings, 2);
+    binary_tree_s *top = bst_rotate_left(root);
+    top->left = fix_left_shorter(root, shorter); // a red node always makes up for the loss
+    return top;
+  }
+  if ((sibling->left == NULL || sibling->left->color == BLACK) &&
+      (sibling->right == NULL || sibling->right->color == BLACK)) {
+    sibling->color = RED;
+    BST_COUNT(recolorings);
+    *shorter = root->color == BLACK;
+    if (root->color == RED) {
+      root->color = BLACK;
+      BST_COUNT(recolorings);
     }
-    // If the value matches the current node's value
-    // (should not happen in a valid call)
-    return NULL;
+    return root;
+  }
+  if (sibling->right == NULL || sibling->right->color == BLACK) {
+    // Only the inner child of the sibling is red: rotate it above the sibling
+    sibling->left->color = BLACK;
+    sibling->color = RED;
+    BST_ADD(recolorings, 2);
+    sibling = root->right = bst_rotate_right(sibling);
+  }
+  // The outer child of the sibling is red: the sibling takes the place and the color of the node
+  sibling->color = root->color;
+  root->color = BLACK;
+  sibling->right->color = BLACK;
+  BST_ADD(recolorings, 3);
+  *shorter = false;
+  return bst_rotate_left(root);
 }
 
 /**
- * @brief Removes a node with a specified value from the red-black tree.
+ * @brief Restores the black height of a node whose right subtree lost a black node in a removal.
  *
- * This function searches for a node with the specified value and removes it if found.
- * It ensures that the red-black properties are maintained after the node is removed 
- * by performing appropriate rotations and recoloring.
+ * Mirror of fix_left_shorter().
  *
- * @param value The integer value of the node to be removed.
- * @param root The root of the tree or subtree from which the node is to be removed.
+ * @param root The node whose right subtree lost a black node.
+ * @param shorter Set to true if the subtree of the node still has one black node less.
+ * @return The new root of the subtree.
+ */
+static binary_tree_s *fix_right_shorter(binary_tree_s *root, bool *shorter) {
+  binary_tree_s *sibling = root->left;
+  if (sibling->color == RED) {
+    // The node is black: rotate the sibling above it, the node becomes red with a black sibling
+    sibling->color = BLACK;
+    root->color = RED;
+    BST_ADD(recolorings, 2);
+    binary_tree_s *top = bst_rotate_right(root);
+    top->right = fix_right_shorter(root, shorter); // a red node always makes up for the loss
+    return top;
+  }
+  if ((sibling->left == NULL || sibling->left->color == BLACK) &&
+      (sibling->right == NULL || sibling->right->color == BLACK)) {
+    sibling->color = RED;
+    BST_COUNT(recolorings);
+    *shorter = root->color == BLACK;
+    if (root->color == RED) {
+      root->color = BLACK;
+      BST_COUNT(recolorings);
+    }
+    return root;
+  }
+  if (sibling->left == NULL || sibling->left->color == BLACK) {
+    // Only the inner child of the sibling is red: rotate it above the sibling
+    sibling->right->color = BLACK;
+    sibling->color = RED;
+    BST_ADD(recolorings, 2);
+    sibling = root->left = bst_rotate_left(sibling);
+  }
+  // The outer child of the sibling is red: the sibling takes the place and the color of the node
+  sibling->color = root->color;
+  root->color = BLACK;
+  sibling->left->color = BLACK;
+  BST_ADD(recolorings, 3);
+  *shorter = false;
+  return bst_rotate_right(root);
+}
+
+/**
+ * @brief Recursively removes a node with a specified value from a red-black subtree.
  *
- * @details
- * - If the tree is empty, nothing is removed.
- * - Recursively searches for the node to be removed in the left or right subtree.
- * - Once the node is found:
- *   1. **Case 1: Node is red**:
- *      - If the node is a leaf, it is simply removed.
- *      - If the node has one child, the node is replaced with its child.
- *      - If the node has two children, the node's value is replaced with its in-order successor, and the successor is removed.
- *   2. **Case 2.1: Node is black with a single red child (right)**:
- *      - The right child is made black, and the node is replaced with its right child.
- *   3. **Case 2.2: Node is black with a single red child (left)**:
- *      - The left child is made black, and the node is replaced with its left child.
- *   4. **Case 2.3: Node is black with two red children**:
- *      - Both children are made black, the node's value is replaced with its in-order successor, and the successor is removed.
- *   5. **Case 3: Node is black with no children or black children**:
- *      - The sibling is checked for color and children to determine the appropriate rotation and recoloring to maintain balance.
- *      - Various sub-cases handle rotations and recoloring based on the sibling's color and the colors of its children.
+ * A node with two children takes the value of its in-order successor, which is removed from the right
+ * subtree instead. A node with at most one child is replaced by it: in a red-black tree, the child is
+ * then a red leaf below a black node and turns black. Removing a black leaf takes a black node off the
+ * paths through it; the loss is reported to the caller, which restores the black height of its node
+ * with fix_left_shorter() or fix_right_shorter(), or passes the loss further up.
  *
- * @return The new root of the subtree after the node has been removed.
+ * @param value The integer value of the node to be removed.
+ * @param root The root of the subtree; this may be NULL if the subtree is empty.
+ * @param shorter Set to true if the returned subtree has one black node less than the given one.
+ * @return The root of the subtree after the removal.
  */
-binary_tree_s *remove_node(int value, binary_tree_s *root) {
+static binary_tree_s *remove_node_rec(int value, binary_tree_s *root, bool *shorter) {
   if (root == NULL) {
-    // Tree is empty, nothing to remove
-    return root;
+    // Value not found, nothing removed
+    *shorter = false;
+    return NULL;
   }
-  
-  if (value < root->value) {
-    // Recur to the left subtree
-    root->left = remove_node(value, root->left);
-  } else if (value > root->value) {
-    // Recur to the right subtree
-    root->right = remove_node(value, root->right);
-  } else {
-    // Node to be deleted is found
-    printf("to remove %d\n", root->value);
-    // Case 1: Node is red
-    if (root->color == RED) {
-      // If the node is a leaf node, simply remove it
-      if (root->left == NULL && root->right == NULL) {
-	free(root);
-	return NULL;
-      }
-      
-      // If the node has one child, replace the node with its child
-      if (root->left == NULL || root->right == NULL) {
-	binary_tree_s *child = (root->left != NULL) ? root->left : root->right;
-	free(root);
-	return child;
-      }
-      
-      // If the node has two children
-      if (root->left != NULL && root->right != NULL) {
-	// Find the in-order successor (smallest in the right subtree)
-	int successor_value = min_value_node(root->right);
-	// Replace the value of root with the successor's value
-	root->value = successor_value;
-	// Delete the in-order successor
-	root->right = remove_node(successor_value, root->right);
-      }
-    } else {
-      // Case 2.1: Node is black with a single red child (right)
-      if (root->right != NULL && root->right->color == RED&&root->left == NULL){
-	// Make the right child black
-	root->right->color = BLACK;
-	// Replace the root with its right child
-	binary_tree_s *child = root->right;
-	free(root);
-	return child;
-      }
-      
-      // Case 2.2: Node is black with a single red child (left)
-      if (root->left != NULL && root->left->color == RED&&root->right == NULL){
-	// Make the left child black
-	root->left->color = BLACK;
-	// Replace the root with its left child
-	binary_tree_s *child = root->left;
-	free(root);
-	return child;
-      }
-
-      // Case 2.3: Node is black with two red children
-      if (root->left != NULL && root->left->color == RED &&
-	  root->right != NULL && root->right->color == RED) {
-	// Replace the root with its in-order successor
-	int successor_value = min_value_node(root->right);
-	root->value = successor_value;
-	root->right = remove_node(successor_value, root->right);
-	return root; 
-      }
-      
-      // Case 2.3: Node is black with two red children
-      if (root->left != NULL && root->left->color == RED &&
-	  root->right != NULL && root->right->color == RED) {
-	// Make both children black
-	root->left->color = BLACK;
-	root->right->color = BLACK;
-	// Replace the root with its in-order successor
-	int successor_value = min_value_node(root->right);
-	root->value = successor_value;
-	root->right = remove_node(successor_value, root->right);
-	return root;
-      }
-      
-      // Case 3: Node is black with no children or black children
-      binary_tree_s *parent = find_parent(value, root);
-      if (parent != NULL) {
-	binary_tree_s *sibling = (parent->left == root) ? parent->right : parent->left;
-	if (sibling != NULL) {
-	  if (sibling->color == RED) {
-	    // Case 3.1
-	    // Colorise the sibling in black 
-	    sibling->color = BLACK;
-	    // Colorise the parent in red
-	    parent->color = RED;
-	    // Rotation around the parent
-	    if (parent->right == sibling) {
-	      // Left rotation if the sibling is the right child
-	      root = bst_rotate_left(parent);
-	    } else {
-	      // Right rotation if the sibling is the left child
-	      root = bst_rotate_right(parent);
-	    }
-	  } else
-	    if ((sibling->left == NULL || sibling->left->color == BLACK) &&
-		(sibling->right == NULL || sibling->right->color == BLACK)) {
-	      // Case 3.2
-	      // Colore the sibling in red
-	      sibling->color = RED;
-	      // Moving the double black to the parent
-	      if (parent->color == BLACK) {
-		// If the parent is black, then it becomes double black
-		parent->color = BLACK;
-	      } else {
-		// If the parent is red, then it becomes black
-		parent->color = BLACK;
-	      }
-	    } else {
-	      // Case 3.3
-	      if (sibling->left != NULL && sibling->left->color == RED) {
-		// If the sibling has a red internal child (left)
-		sibling->left->color = BLACK;
-		root = bst_rotate_right(sibling);
-		sibling = parent->right; // Update sibling after the rotation
-	      }
-	      if (sibling->right != NULL && sibling->right->color == RED) {
-		// If the sibling has a red external child (right)
-		sibling->color = parent->color;
-		parent->color = BLACK;
-		sibling->right->color = BLACK;
-		root = bst_rotate_left(parent);
-	      }
-	      
-	    }
-	}
-      } else {// parent == NULL
-	if  (root->right != NULL){
-	  // Replace the root with its in-order successor
-	  int successor_value = min_value_node(root->right);
-	  root->value = successor_value;
-	  root->right = remove_node(successor_value, root->right);
-	} else {
-	  root = NULL;
-	}
-      }
-    }
+  BST_COUNT(visits);
+  if (BST_COMPARE(value < root->value)) {
+    root->left = remove_node_rec(value, root->left, shorter);
+    return *shorter ? fix_left_shorter(root, shorter) : root;
+  }
+  if (BST_COMPARE(value > root->value)) {
+    root->right = remove_node_rec(value, root->right, shorter);
+    return *shorter ? fix_right_shorter(root, shorter) : root;
+  }
+  if (root->left != NULL && root->right != NULL) {
+    // Replace the value with the in-order successor (smallest in the right subtree), then remove it
+    root->value = rb_min_value_node(root->right);
+    root->right = remove_node_rec(root->value, root->right, shorter);
+    return *shorter ? fix_right_shorter(root, shorter) : root;
   }
+  binary_tree_s *child = (root->left != NULL) ? root->left : root->right;
+  *shorter = root->color == BLACK && child == NULL;
+  if (child != NULL) {
+    child->color = BLACK;
+    BST_COUNT(recolorings);
+  }
+  free(root);
+  return child;
+}
 
+/**
+ * @brief Removes a node with a specified value from the red-black tree and ensures the root remains black.
+ *
+ * This function serves as the public API for removing values from a red-black tree. It calls
+ * `remove_node_rec`, which rebalances the tree on the way back up, so that every path from the root
+ * to a leaf keeps the same number of black nodes and no red node has a red child. The height of the
+ * tree thus stays within 2 * log2(n + 1) whatever the sequence of additions and removals.
+ *
+ * @param value The integer value of the node to be removed.
+ * @param root The root of the red-black tree; this can be NULL if the tree is empty.
+ *
+ * @return The root of the red-black tree after the removal, or NULL if the tree is now empty.
+ */
+static binary_tree_s *rb_remove_node(int value, binary_tree_s *root) {
+  bool shorter;
+  root = remove_node_rec(value, root, &shorter);
+  if (root != NULL && root->color == RED) {
+    root->color = BLACK;
+    BST_COUNT(recolorings);
+  }
   return root;
 }
 
@@ -582,13 +558,30 @@ binary_tree_s *remove_node(int value, binary_tree_s *root) {
  *
  * @param tree Pointer to the root of the binary tree to be freed.
  */
-void binary_tree_free(binary_tree_s *tree) {
+static void rb_binary_tree_free(binary_tree_s *tree) {
   if(tree==NULL)
     return;
   if(tree->left != NULL)
-    binary_tree_free(tree->left);
+    rb_binary_tree_free(tree->left);
   if(tree->right !=NULL)
-    binary_tree_free(tree->right);
+    rb_binary_tree_free(tree->right);
   free(tree);
 }
 
+/**
+ * @brief Operations of the red-black tree engine.
+ */
+const bst_ops_t rb_bst_ops = {
+  .name = "rb",
+  .add_node = rb_add_node,
+  .find_node = rb_find_node,
+  .remove_node = rb_remove_node,
+  .binary_tree_height = rb_binary_tree_height,
+  .binary_tree_nodes = rb_binary_tree_nodes,
+  .min_value_node = rb_min_value_node,
+  .dump_tree = rb_dump_tree,
+  .binary_tree_to_array = rb_binary_tree_to_array,
+  .binary_tree_print = rb_binary_tree_print,
+  .binary_tree_free = rb_binary_tree_free,
+  .stats = true,
+};
@@ -0,0 +1,640 @@
+/**
+ * @file roaring_bst.c
+ * @brief Implementation of the binary search tree operations in C using a roaring bitmap.
+ *
+ * This file contains an implementation of the ordered set operations of bst.h as a roaring bitmap
+ * (Chambi, Lemire, Kaser and Godin). The value is mapped to an unsigned key whose order is the order of
+ * the values, and the keys are split in chunks of 65536 by their 16 high bits. Each non empty chunk is
+ * a container, kept in a sorted index, which stores the 16 low bits of its keys in the smallest of :
+ * - an array of sorted values, while it holds at most ARRAY_MAX values (2 bytes per value),
+ * - a bitmap of 65536 bits (8 KiB, whatever the number of values),
+ * - a list of runs of consecutive values (4 bytes per run).
+ *
+ * An array which is full becomes a bitmap, and a bitmap which falls to ARRAY_MAX values becomes an array.
+ * A run container is checked after each operation and array and bitmap containers every 1024 values, and
+ * are converted to the run representation when it is smaller, so that dense ranges take a few bytes.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "bst.h"
+
+/**
+ * @brief Maximal number of values of an array container.
+ */
+#define ARRAY_MAX 4096
+
+/**
+ * @brief Number of 64 bits words of a bitmap container.
+ */
+#define BITMAP_WORDS 1024
+
+/**
+ * @brief Number of values added or removed between two checks of the representation of a container.
+ */
+#define CHECK_PERIOD 1024
+
+/**
+ * @enum container_type_e
+ * @brief Enumerates the representations of a container.
+ */
+enum container_type_e {
+  ARRAY,   /**< Sorted array of the low bits. */
+  BITMAP,  /**< Bitmap of 65536 bits. */
+  RUN      /**< Sorted array of runs of consecutive low bits. */
+};
+
+/**
+ * @struct run_s
+ * @brief A run of consecutive values.
+ */
+typedef struct {
+  uint16_t start;                    /**< The first value of the run */
+  uint16_t length;                   /**< The number of values of the run minus one */
+} run_s;
+
+/**
+ * @struct container_s
+ * @brief A container holding the values of a chunk.
+ */
+typedef struct {
+  uint16_t key;                      /**< The 16 high bits shared by the values of the chunk */
+  uint8_t type;                      /**< The representation of the container (container_type_e) */
+  int cardinality;                   /**< The number of values */
+  int length;                        /**< The number of elements of the array or of runs */
+  int capacity;                      /**< The number of elements allocated for the array or the runs */
+  union {
+    uint16_t *array;                 /**< The sorted values, for an array container */
+    uint64_t *bitmap;                /**< The bits of the values, for a bitmap container */
+    run_s *runs;                     /**< The sorted runs, for a run container */
+  };
+} container_s;
+
+/**
+ * @struct binary_tree_s
+ * @brief A structure to represent a roaring bitmap.
+ *
+ * An empty bitmap is represented by NULL.
+ */
+typedef struct binary_tree {
+  int size;                          /**< The number of values in the bitmap */
+  int count;                         /**< The number of containers */
+  int capacity;                      /**< The number of containers allocated */
+  container_s *containers;           /**< The containers, sorted by key */
+} binary_tree_s;
+
+/**
+ * @brief Maps a value to a key whose unsigned order is the order of the values.
+ */
+static inline uint32_t to_key(int value) {
+  return (uint32_t)value ^ 0x80000000u;
+}
+
+/**
+ * @brief Maps the high and low bits of a key back to its value.
+ */
+static inline int to_value(uint16_t high, uint16_t low) {
+  return (int)((((uint32_t)high << 16) | low) ^ 0x80000000u);
+}
+
+/**
+ * @brief Finds the container of a chunk in the index.
+ *
+ * @param tree The roaring bitmap.
+ * @param key The high bits of the chunk.
+ * @param found Output : true if the container exists.
+ * @return The position of the container, or the position where it must be inserted.
+ */
+static int find_container(binary_tree_s *tree, uint16_t key, bool *found) {
+  int low = 0, high = tree->count;
+  while (low < high) {
+    int middle = (low + high) / 2;
+    if (tree->containers[middle].key < key)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  *found = low < tree->count && tree->containers[low].key == key;
+  return low;
+}
+
+/**
+ * @brief Finds the first element of a sorted array which is not lower than a value.
+ */
+static int array_lower_bound(const uint16_t *array, int n, uint16_t value) {
+  int low = 0, high = n;
+  while (low < high) {
+    int middle = (low + high) / 2;
+    if (array[middle] < value)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  return low;
+}
+
+/**
+ * @brief Finds the last run starting at or before a value.
+ * @return The position of the run, -1 if all the runs start after the value.
+ */
+static int run_search(const run_s *runs, int n, uint16_t value) {
+  int low = 0, high = n;
+  while (low < high) {
+    int middle = (low + high) / 2;
+    if (runs[middle].start <= value)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  return low - 1;
+}
+
+/**
+ * @brief Makes room for one more element in the array or the runs of a container.
+ *
+ * @param c The container.
+ * @param size The size of an element.
+ */
+static void container_reserve(container_s *c, size_t size) {
+  if (c->length < c->capacity)
+    return;
+  c->capacity = c->capacity == 0 ? 4 : 2 * c->capacity;
+  c->array = realloc(c->array, c->capacity * size);
+  assert(c->array != NULL);
+}
+
+/**
+ * @brief Counts the runs of consecutive values of a container.
+ *
+ * A bitmap counts the first bits of its runs, i.e. the set bits whose previous bit is clear, with popcount.
+ */
+static int container_runs(container_s *c) {
+  int runs = 0;
+  switch (c->type) {
+  case ARRAY:
+    for (int i = 0; i < c->length; i++)
+      runs += (i == 0 || c->array[i] != c->array[i - 1] + 1);
+    return runs;
+  case BITMAP: {
+    uint64_t carry = 0;
+    for (int i = 0; i < BITMAP_WORDS; i++) {
+      uint64_t word = c->bitmap[i];
+      runs += __builtin_popcountll(word & ~((word << 1) | carry));
+      carry = word >> 63;
+    }
+    return runs;
+  }
+  default:
+    return c->length;
+  }
+}
+
+/**
+ * @brief Copies the values of a container in ascending order into an array.
+ *
+ * @param c The container.
+ * @param values The array receiving the low bits, large enough for all the values of the container.
+ * @return The number of values copied.
+ */
+static int container_values(container_s *c, uint16_t *values) {
+  int n = 0;
+  switch (c->type) {
+  case ARRAY:
+    memcpy(values, c->array, c->length * sizeof(uint16_t));
+    return c->length;
+  case BITMAP:
+    for (int i = 0; i < BITMAP_WORDS; i++)
+      for (uint64_t word = c->bitmap[i]; word != 0; word &= word - 1)
+        values[n++] = i * 64 + __builtin_ctzll(word);
+    return n;
+  default:
+    for (int i = 0; i < c->length; i++)
+      for (int v = 0; v <= c->runs[i].length; v++)
+        values[n++] = c->runs[i].start + v;
+    return n;
+  }
+}
+
+/**
+ * @brief Changes the representation of a container.
+ *
+ * @param c The container.
+ * @param type The new representation.
+ */
+static void container_convert(container_s *c, enum container_type_e type) {
+  uint16_t *values = malloc(c->cardinality * sizeof(uint16_t));
+  assert(values != NULL);
+  int n = container_values(c, values);
+  free(c->array);
+  c->type = type;
+  c->length = 0;
+  switch (type) {
+  case ARRAY:
+    c->array = values;
+    c->length = c->capacity = n;
+    return;
+  case BITMAP:
+    c->bitmap = calloc(BITMAP_WORDS, sizeof(uint64_t));
+    assert(c->bitmap != NULL);
+    for (int i = 0; i < n; i++)
+      c->bitmap[values[i] / 64] |= 1ull << (values[i] % 64);
+    c->capacity = 0;
+    break;
+  default:
+    c->runs = NULL;
+    c->capacity = 0;
+    for (int i = 0; i < n; i++) {
+      if (c->length > 0 && c->runs[c->length - 1].start + c->runs[c->length - 1].length + 1 == values[i]) {
+        c->runs[c->length - 1].length++;
+      } else {
+        container_reserve(c, sizeof(run_s));
+        c->runs[c->length++] = (run_s){ values[i], 0 };
+      }
+    }
+    break;
+  }
+  free(values);
+}
+
+/**
+ * @brief Converts a container to its smallest representation.
+ *
+ * @param c The container.
+ * @param runs The number of runs of the container.
+ */
+static void container_optimize(container_s *c, int runs) {
+  int run_bytes = runs * (int)sizeof(run_s);
+  int other_bytes = c->cardinality <= ARRAY_MAX ? c->cardinality * (int)sizeof(uint16_t)
+                                                : BITMAP_WORDS * (int)sizeof(uint64_t);
+  enum container_type_e best = run_bytes < other_bytes ? RUN : c->cardinality <= ARRAY_MAX ? ARRAY : BITMAP;
+  if (best != c->type)
+    container_convert(c, best);
+}
+
+/**
+ * @brief Checks whether a container holds a value.
+ */
+static bool container_find(container_s *c, uint16_t low) {
+  switch (c->type) {
+  case ARRAY: {
+    int i = array_lower_bound(c->array, c->length, low);
+    return i < c->length && c->array[i] == low;
+  }
+  case BITMAP:
+    return (c->bitmap[low / 64] >> (low % 64)) & 1;
+  default: {
+    int i = run_search(c->runs, c->length, low);
+    return i >= 0 && low - c->runs[i].start <= c->runs[i].length;
+  }
+  }
+}
+
+/**
+ * @brief Adds a value to a container.
+ *
+ * @param c The container.
+ * @param low The low bits of the value.
+ * @return true if the value was added, false if it was already present.
+ */
+static bool container_add(container_s *c, uint16_t low) {
+  if (c->type == ARRAY) {
+    int i = array_lower_bound(c->array, c->length, low);
+    if (i < c->length && c->array[i] == low)
+      return false;
+    if (c->length == ARRAY_MAX) {
+      container_convert(c, BITMAP);
+      return container_add(c, low);
+    }
+    container_reserve(c, sizeof(uint16_t));
+    memmove(c->array + i + 1, c->array + i, (c->length - i) * sizeof(uint16_t));
+    c->array[i] = low;
+    c->length++;
+  } else if (c->type == BITMAP) {
+    uint64_t bit = 1ull << (low % 64);
+    if (c->bitmap[low / 64] & bit)
+      return false;
+    c->bitmap[low / 64] |= bit;
+  } else {
+    int i = run_search(c->runs, c->length, low);
+    if (i >= 0 && low - c->runs[i].start <= c->runs[i].length)
+      return false;
+    bool joins_left = i >= 0 && c->runs[i].start + c->runs[i].length + 1 == low;
+    bool joins_right = i + 1 < c->length && c->runs[i + 1].start == low + 1;
+    if (joins_left && joins_right) {
+      c->runs[i].length += c->runs[i + 1].length + 2;
+      memmove(c->runs + i + 1, c->runs + i + 2, (c->length - i - 2) * sizeof(run_s));
+      c->length--;
+    } else if (joins_left) {
+      c->runs[i].length++;
+    } else if (joins_right) {
+      c->runs[i + 1].start--;
+      c->runs[i + 1].length++;
+    } else {
+      container_reserve(c, sizeof(run_s));
+      memmove(c->runs + i + 2, c->runs + i + 1, (c->length - i - 1) * sizeof(run_s));
+      c->runs[i + 1] = (run_s){ low, 0 };
+      c->length++;
+    }
+  }
+  c->cardinality++;
+  if (c->type == RUN || c->cardinality % CHECK_PERIOD == 0)
+    container_optimize(c, container_runs(c));
+  return true;
+}
+
+/**
+ * @brief Removes a value from a container.
+ *
+ * @param c The container.
+ * @param low The low bits of the value.
+ * @return true if the value was removed, false if it was not present.
+ */
+static bool container_remove(container_s *c, uint16_t low) {
+  if (c->type == ARRAY) {
+    int i = array_lower_bound(c->array, c->length, low);
+    if (i == c->length || c->array[i] != low)
+      return false;
+    memmove(c->array + i, c->array + i + 1, (c->length - i - 1) * sizeof(uint16_t));
+    c->length--;
+  } else if (c->type == BITMAP) {
+    uint64_t bit = 1ull << (low % 64);
+    if (!(c->bitmap[low / 64] & bit))
+      return false;
+    c->bitmap[low / 64] &= ~bit;
+  } else {
+    int i = run_search(c->runs, c->length, low);
+    if (i < 0 || low - c->runs[i].start > c->runs[i].length)
+      return false;
+    run_s *run = &c->runs[i];
+    int end = run->start + run->length;
+    if (run->length == 0) {
+      memmove(c->runs + i, c->runs + i + 1, (c->length - i - 1) * sizeof(run_s));
+      c->length--;
+    } else if (low == run->start) {
+      run->start++;
+      run->length--;
+    } else if (low == end) {
+      run->length--;
+    } else {
+      // Split the run around the value
+      run->length = low - run->start - 1;
+      container_reserve(c, sizeof(run_s));
+      memmove(c->runs + i + 2, c->runs + i + 1, (c->length - i - 1) * sizeof(run_s));
+      c->runs[i + 1] = (run_s){ low + 1, end - low - 1 };
+      c->length++;
+    }
+  }
+  c->cardinality--;
+  if (c->cardinality > 0 && (c->type == RUN || c->cardinality % CHECK_PERIOD == 0 ||
+                             (c->type == BITMAP && c->cardinality == ARRAY_MAX)))
+    container_optimize(c, container_runs(c));
+  return true;
+}
+
+/**
+ * @brief Calculates the height of the roaring bitmap.
+ *
+ * @param tree The roaring bitmap.
+ * @return 1, the containers being the only level under the index. Returns -1 if the bitmap is empty.
+ */
+static int roaring_binary_tree_height(binary_tree_s *tree) {
+  if (tree == NULL)
+    return -1;
+  return 1;
+}
+
+/**
+ * @brief Counts the number of values in the roaring bitmap.
+ *
+ * @param tree The roaring bitmap.
+ * @return The number of values. Returns 0 if the bitmap is empty.
+ */
+static int roaring_binary_tree_nodes(binary_tree_s *tree) {
+  if (tree == NULL)
+    return 0;
+  return tree->size;
+}
+
+/**
+ * @brief Public function to print the entire roaring bitmap.
+ *
+ * Each container is printed with its chunk and its representation, followed by its values for an array,
+ * its runs for a run container and its number of values for a bitmap.
+ *
+ * @param tree The roaring bitmap to be printed.
+ */
+static void roaring_binary_tree_print(binary_tree_s *tree) {
+  static const char *names[] = { "array", "bitmap", "run" };
+  int height = roaring_binary_tree_height(tree);
+  int nodes = roaring_binary_tree_nodes(tree);
+  printf("height : %d  - nodes : %d\n", height, nodes);
+  if (height < 0) {
+    printf("Empty binary tree.\n");
+    return;
+  }
+  for (int i = 0; i < tree->count; i++) {
+    container_s *c = &tree->containers[i];
+    printf("%s%04x─[%s] ", i == tree->count - 1 ? "└" : "├", c->key, names[c->type]);
+    if (c->type == ARRAY)
+      for (int j = 0; j < c->length; j++)
+        printf("(%04d)", to_value(c->key, c->array[j]));
+    else if (c->type == RUN)
+      for (int j = 0; j < c->length; j++)
+        printf("(%04d..%04d)", to_value(c->key, c->runs[j].start),
+               to_value(c->key, c->runs[j].start + c->runs[j].length));
+    else
+      printf("%d values", c->cardinality);
+    printf("\n");
+  }
+  return;
+}
+
+/**
+ * @brief Find the minimum value in the roaring bitmap.
+ *
+ * @param tree The roaring bitmap, which must not be empty.
+ * @return the minimum value.
+ */
+static int roaring_min_value_node(binary_tree_s *tree) {
+  assert(tree != NULL);
+  container_s *c = &tree->containers[0];
+  switch (c->type) {
+  case ARRAY:
+    return to_value(c->key, c->array[0]);
+  case BITMAP: {
+    int i = 0;
+    while (c->bitmap[i] == 0)
+      i++;
+    return to_value(c->key, i * 64 + __builtin_ctzll(c->bitmap[i]));
+  }
+  default:
+    return to_value(c->key, c->runs[0].start);
+  }
+}
+
+/**
+ * @brief Adds a value to the roaring bitmap.
+ *
+ * If the value already exists in the bitmap, the bitmap is returned unchanged.
+ *
+ * @param value The value to be added.
+ * @param tree The roaring bitmap (can be NULL if the bitmap is empty).
+ * @return The modified roaring bitmap.
+ */
+static binary_tree_s *roaring_add_node(int value, binary_tree_s *tree) {
+  if (tree == NULL) {
+    tree = calloc(1, sizeof(binary_tree_s));
+    assert(tree != NULL);
+  }
+  uint32_t key = to_key(value);
+  bool found;
+  int i = find_container(tree, key >> 16, &found);
+  if (!found) {
+    if (tree->count == tree->capacity) {
+      tree->capacity = tree->capacity == 0 ? 4 : 2 * tree->capacity;
+      tree->containers = realloc(tree->containers, tree->capacity * sizeof(container_s));
+      assert(tree->containers != NULL);
+    }
+    memmove(tree->containers + i + 1, tree->containers + i, (tree->count - i) * sizeof(container_s));
+    tree->containers[i] = (container_s){ .key = key >> 16, .type = ARRAY };
+    tree->count++;
+  }
+  if (container_add(&tree->containers[i], key & 0xffff))
+    tree->size++;
+  return tree;
+}
+
+/**
+ * @brief Checks whether a value exists in the roaring bitmap.
+ *
+ * @param value The value to search for.
+ * @param tree The roaring bitmap.
+ * @return true if the value is found, false otherwise.
+ */
+static bool roaring_find_node(int value, binary_tree_s *tree) {
+  if (tree == NULL)
+    return false;
+  uint32_t key = to_key(value);
+  bool found;
+  int i = find_container(tree, key >> 16, &found);
+  return found && container_find(&tree->containers[i], key & 0xffff);
+}
+
+/**
+ * @brief Prints all values in the roaring bitmap in a sorted order.
+ *
+ * The values are displayed in ascending order if `ascending` is true, and in descending order if
+ * `ascending` is false.
+ *
+ * @param tree The roaring bitmap to be dumped.
+ * @param ascending Specifies the order of the output: true for ascending, false for descending.
+ */
+static void roaring_dump_tree(binary_tree_s *tree, bool ascending) {
+  if (tree == NULL)
+    return;
+  uint16_t *values = malloc(65536 * sizeof(uint16_t));
+  assert(values != NULL);
+  for (int i = 0; i < tree->count; i++) {
+    container_s *c = &tree->containers[ascending ? i : tree->count - 1 - i];
+    int n = container_values(c, values);
+    for (int j = 0; j < n; j++)
+      printf("%d ", to_value(c->key, values[ascending ? j : n - 1 - j]));
+  }
+  free(values);
+  return;
+}
+
+/**
+ * @brief Copies all values of the roaring bitmap in ascending order into an array.
+ *
+ * @param tree The roaring bitmap.
+ * @param array The array receiving the values, large enough for all the values of the bitmap.
+ * @return The number of values copied.
+ */
+static int roaring_binary_tree_to_array(binary_tree_s *tree, int *array) {
+  if (tree == NULL)
+    return 0;
+  uint16_t *values = malloc(65536 * sizeof(uint16_t));
+  assert(values != NULL);
+  int n = 0;
+  for (int i = 0; i < tree->count; i++) {
+    container_s *c = &tree->containers[i];
+    int count = container_values(c, values);
+    for (int j = 0; j < count; j++)
+      array[n++] = to_value(c->key, values[j]);
+  }
+  free(values);
+  return n;
+}
+
+/**
+ * @brief Removes a value from the roaring bitmap if it exists.
+ *
+ * A container left without values is removed from the index.
+ *
+ * @param value The value to be removed.
+ * @param tree The roaring bitmap.
+ * @return The modified roaring bitmap; NULL if the bitmap is empty after removal.
+ */
+static binary_tree_s *roaring_remove_node(int value, binary_tree_s *tree) {
+  if (tree == NULL)
+    return NULL;
+  uint32_t key = to_key(value);
+  bool found;
+  int i = find_container(tree, key >> 16, &found);
+  if (!found || !container_remove(&tree->containers[i], key & 0xffff))
+    return tree; // Value not found
+  tree->size--;
+  if (tree->containers[i].cardinality == 0) {
+    free(tree->containers[i].array);
+    memmove(tree->containers + i, tree->containers + i + 1, (tree->count - i - 1) * sizeof(container_s));
+    tree->count--;
+  }
+  if (tree->size == 0) {
+    free(tree->containers);
+    free(tree);
+    return NULL;
+  }
+  return tree;
+}
+
+/**
+ * @brief Frees the memory occupied by a roaring bitmap.
+ *
+ * It safely handles bitmaps that are NULL by terminating early.
+ *
+ * @param tree Pointer to the roaring bitmap to be freed.
+ */
+static void roaring_binary_tree_free(binary_tree_s *tree) {
+  if (tree == NULL)
+    return;
+  for (int i = 0; i < tree->count; i++)
+    free(tree->containers[i].array);
+  free(tree->containers);
+  free(tree);
+}
+
+/**
+ * @brief Operations of the roaring bitmap engine.
+ */
+const bst_ops_t roaring_bst_ops = {
+  .name = "roaring",
+  .add_node = roaring_add_node,
+  .find_node = roaring_find_node,
+  .remove_node = roaring_remove_node,
+  .binary_tree_height = roaring_binary_tree_height,
+  .binary_tree_nodes = roaring_binary_tree_nodes,
+  .min_value_node = roaring_min_value_node,
+  .dump_tree = roaring_dump_tree,
+  .binary_tree_to_array = roaring_binary_tree_to_array,
+  .binary_tree_print = roaring_binary_tree_print,
+  .binary_tree_free = roaring_binary_tree_free,
+};
@@ -0,0 +1,488 @@
+/**
+ * @file scapegoat_bst.c
+ * @brief Implementation of a binary search tree in C using a scapegoat tree.
+ *
+ * This file contains the implementation of a scapegoat tree (Galperin and Rivest). The nodes have exactly
+ * the layout of the naive binary search tree (a value and two children) : no height, no color and no
+ * priority is stored. The balance is restored by rebuilding a whole subtree into a perfectly balanced one
+ * when an insertion goes deeper than log_{1/alpha}(n), or the whole tree when enough removals occurred.
+ * The rebuild flattens the subtree into a list threaded through the right pointers and rebuilds it in
+ * linear time without any allocation.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include "bst.h"
+
+/**
+ * @brief Balance parameter alpha of the tree, written as the fraction ALPHA_NUM / ALPHA_DEN.
+ *
+ * A subtree is alpha-weight-balanced when none of its children holds more than alpha times its nodes.
+ */
+#define ALPHA_NUM 2
+#define ALPHA_DEN 3
+
+/**
+ * @brief Maximal depth of a search path, the depth being bounded by log_{1/alpha}(n) + 1 with n < 2^31.
+ */
+#define MAX_DEPTH 64
+
+/**
+ * @struct node_s
+ * @brief A structure to represent a node in a scapegoat tree.
+ *
+ * This structure holds the value of the node and pointers to the left and right child nodes.
+ */
+typedef struct node {
+  int value;                         /**< The value of the node */
+  struct node *left;                 /**< Pointer to the left child */
+  struct node *right;                /**< Pointer to the right child */
+} node_s;
+
+/**
+ * @struct binary_tree_s
+ * @brief A structure to represent a scapegoat tree.
+ *
+ * The counters needed to detect an unbalanced tree are kept once per tree instead of in each node.
+ * An empty tree is represented by NULL.
+ */
+typedef struct binary_tree {
+  node_s *root;                      /**< Pointer to the root node */
+  int size;                          /**< The number of nodes in the tree */
+  int max_size;                      /**< The maximal size reached since the last complete rebuild */
+} binary_tree_s;
+
+/**
+ * @brief Computes the maximal depth allowed in a tree of a given size, i.e. floor(log_{1/alpha}(size)).
+ *
+ * @param size The number of nodes in the tree.
+ * @return The maximal depth allowed.
+ */
+static int depth_bound(int size) {
+  int bound = 0;
+  double weight = (double)ALPHA_DEN / ALPHA_NUM;
+  while (weight <= size) {
+    weight = weight * ALPHA_DEN / ALPHA_NUM;
+    bound++;
+  }
+  return bound;
+}
+
+/**
+ * @brief Counts the nodes of a subtree.
+ *
+ * @param node The root of the subtree.
+ * @return The number of nodes in the subtree.
+ */
+static int node_count(node_s *node) {
+  if (node == NULL)
+    return 0;
+  BST_COUNT(visits);
+  return node_count(node->left) + node_count(node->right) + 1;
+}
+
+/**
+ * @brief Computes the height of a subtree.
+ *
+ * @param node The root of the subtree.
+ * @return The height of the subtree; -1 if it is empty.
+ */
+static int node_height(node_s *node) {
+  if (node == NULL)
+    return -1;
+  int left  = node_height(node->left);
+  int right = node_height(node->right);
+  return 1 + ((left > right) ? left : right);
+}
+
+/**
+ * @brief Calculates the height of the binary tree.
+ *
+ * The height of a tree is the number of edges along the longest path from the root down to the farthest leaf node.
+ *
+ * @param tree The binary tree.
+ * @return The height of the tree. Returns -1 if the tree is empty.
+ */
+static int scapegoat_binary_tree_height(binary_tree_s *tree) {
+  if (tree == NULL)
+    return -1;
+  return node_height(tree->root);
+}
+
+/**
+ * @brief Counts the total number of nodes in the binary tree.
+ *
+ * The number of nodes is maintained by the tree, so no traversal is needed.
+ *
+ * @param tree The binary tree.
+ * @return The total number of nodes in the tree. Returns 0 if the tree is empty.
+ */
+static int scapegoat_binary_tree_nodes(binary_tree_s *tree) {
+  if (tree == NULL)
+    return 0;
+  return tree->size;
+}
+
+/**
+ * @brief Internal helper function to print the binary tree.
+ *
+ * This recursive function assists in printing the binary tree in a structured ASCII art format.
+ * The function utilizes depth to determine the prefixes and branching structure for each node.
+ *
+ * @param node The current node being printed.
+ * @param depth The current depth in the tree.
+ * @param height The height of the tree.
+ * @param is_left Flag indicating if the current node is a left child.
+ * @param prefix The current prefix for aligning the printed output.
+ */
+static void binary_tree_print_aux(node_s *node, int depth, int height, int is_left, char *prefix) {
+  char new_prefix[200]; // Buffer limited to 200 bytes (<200 characters)
+  if (node == NULL) return;
+  // print right
+  if (node->right != NULL) {
+    char *s1 = (is_left) ? "│" : " ";
+    char *s2 = (is_left) ? " " : "│";
+    snprintf(new_prefix, sizeof(new_prefix), "%s%s      ", prefix, s1);
+    binary_tree_print_aux(node->right, depth + 1, height, 0, new_prefix);
+    snprintf(new_prefix, sizeof(new_prefix), "%s%s      ", prefix, s2);
+  }
+  // print node
+  printf("%s", prefix);
+  char *s1 = (depth) ? ((is_left) ? "└" : "┌") : " ";
+  char *s2 = (depth >= height ) ? " " : ((node->left) ? ((node->right) ? "┤" : "┐" ) : ((node->right) ? "┘"  : " "));
+  printf("%s(%04d)%s\n", s1, node->value, s2);
+  // print left
+  if (node->left != NULL) {
+    char *s1 = (depth) ? ((is_left) ? " " : "│") : " ";
+    char *s2 = (depth) ? ((is_left) ? "│" : " ") : " ";
+    snprintf(new_prefix, sizeof(new_prefix), "%s%s      ", prefix, s1);
+    binary_tree_print_aux(node->left, depth + 1, height, 1, new_prefix);
+    snprintf(new_prefix, sizeof(new_prefix), "%s%s      ", prefix, s2);
+  }
+  return;
+}
+
+/**
+ * @brief Public function to print the entire binary tree.
+ *
+ * This function prints the binary tree starting from the root. It displays the tree's height and number of nodes
+ * before printing the tree structure.
+ *
+ * @param tree The binary tree to be printed.
+ */
+static void scapegoat_binary_tree_print(binary_tree_s *tree) {
+  int height = scapegoat_binary_tree_height(tree);
+  int nodes = scapegoat_binary_tree_nodes(tree);
+  printf("height : %d  - nodes : %d\n", height, nodes);
+  if (height>=0)
+    binary_tree_print_aux(tree->root, 0, height, 0, "");
+  else
+    printf("Empty binary tree.\n");
+  return;
+}
+
+/**
+ * @brief Find the minimum value in a binary search tree.
+ *
+ * @param tree The binary tree, which must not be empty.
+ * @return the minimum value in the given tree.
+ */
+static int scapegoat_min_value_node(binary_tree_s *tree) {
+  assert(tree != NULL);
+  node_s *node = tree->root;
+  BST_COUNT(visits);
+  while (node->left != NULL) {
+    node = node->left;
+    BST_COUNT(visits);
+  }
+  return node->value;
+}
+
+/**
+ * @brief Flattens a subtree into a list threaded through the right pointers.
+ *
+ * The nodes of the subtree are linked in ascending order and followed by the given list.
+ *
+ * @param node The root of the subtree to flatten.
+ * @param list The list appended after the nodes of the subtree.
+ * @return The head of the resulting list.
+ */
+static node_s *flatten(node_s *node, node_s *list) {
+  if (node == NULL)
+    return list;
+  node->right = flatten(node->right, list);
+  return flatten(node->left, node);
+}
+
+/**
+ * @brief Builds a perfectly balanced tree from the first nodes of a list threaded through the right pointers.
+ *
+ * @param n The number of nodes to take from the list.
+ * @param list The head of the list, which must hold at least n+1 nodes.
+ * @return The (n+1)-th node of the list, whose left child is the balanced tree built from the n first nodes.
+ */
+static node_s *build(int n, node_s *list) {
+  if (n == 0) {
+    list->left = NULL;
+    return list;
+  }
+  node_s *root = build(n / 2, list);
+  node_s *last = build((n - 1) / 2, root->right);
+  root->right = last->left;
+  last->left = root;
+  return last;
+}
+
+/**
+ * @brief Rebuilds a subtree into a perfectly balanced one, in linear time and without allocation.
+ *
+ * @param node The root of the subtree.
+ * @param n The number of nodes of the subtree.
+ * @return The root of the rebuilt subtree.
+ */
+static node_s *rebuild(node_s *node, int n) {
+  node_s anchor; // terminates the list, its left child receives the rebuilt tree
+  anchor.left = anchor.right = NULL;
+  BST_ADD(rebuilt, n);
+  build(n, flatten(node, &anchor));
+  return anchor.left;
+}
+
+/**
+ * @brief Adds a node with a specific value to the scapegoat tree.
+ *
+ * The value is inserted as in a naive binary search tree while the search path is recorded. If the new
+ * node is deeper than log_{1/alpha}(n), the path is walked back up until an ancestor holding more than
+ * alpha times the nodes of its parent is found : the parent is the scapegoat, and its subtree is rebuilt.
+ * If the value already exists in the tree, the tree is returned unchanged.
+ *
+ * @param value The value to be added to the tree.
+ * @param tree The binary tree (can be NULL if the tree is empty).
+ * @return The modified tree.
+ */
+static binary_tree_s *scapegoat_add_node(int value, binary_tree_s *tree) {
+  if (tree == NULL) {
+    tree = malloc(sizeof(binary_tree_s));
+    assert(tree != NULL);
+    tree->root = NULL;
+    tree->size = tree->max_size = 0;
+  }
+  node_s **path[MAX_DEPTH]; // links followed from the root down to the new node
+  int depth = 0;
+  node_s **link = &tree->root;
+  while (*link != NULL) {
+    BST_COUNT(visits);
+    if (BST_COMPARE((*link)->value == value))
+      return tree;
+    assert(depth < MAX_DEPTH);
+    path[depth++] = link;
+    link = BST_COMPARE(value < (*link)->value) ? &(*link)->left : &(*link)->right;
+  }
+  node_s *res = malloc(sizeof(node_s));
+  assert(res != NULL);
+  BST_COUNT(allocations);
+  res->value = value;
+  res->left = res->right = NULL;
+  *link = res;
+  tree->size++;
+  if (tree->size > tree->max_size)
+    tree->max_size = tree->size;
+  if (depth > depth_bound(tree->size)) {
+    // Look for the scapegoat, i.e. the first ancestor which is not alpha-weight-balanced
+    node_s *child = res;
+    int child_size = 1;
+    while (depth > 0) {
+      node_s *parent = *path[--depth];
+      node_s *sibling = (parent->left == child) ? parent->right : parent->left;
+      int parent_size = child_size + node_count(sibling) + 1;
+      if (ALPHA_DEN * child_size > ALPHA_NUM * parent_size) {
+        *path[depth] = rebuild(parent, parent_size);
+        break;
+      }
+      child = parent;
+      child_size = parent_size;
+    }
+  }
+  return tree;
+}
+
+/**
+ * @brief Searches for a node with a specific value in the binary tree.
+ *
+ * This function checks if the tree contains a node with the specified value using a binary search approach.
+ * It returns true if the value is found and false otherwise.
+ *
+ * @param value The value to search for in the tree.
+ * @param tree The binary tree.
+ * @return true if the value is found, false otherwise.
+ */
+static bool scapegoat_find_node(int value, binary_tree_s *tree) {
+  if (tree == NULL)
+    return false;
+  node_s *node = tree->root;
+  while (node != NULL) {
+    BST_COUNT(visits);
+    if (BST_COMPARE(node->value == value))
+      return true;
+    node = BST_COMPARE(node->value < value) ? node->right : node->left;
+  }
+  return false;
+}
+
+/**
+ * @brief Prints all values of a subtree in a sorted order.
+ *
+ * @param node The root of the subtree.
+ * @param ascending Specifies the order of the output: true for ascending, false for descending.
+ */
+static void dump_nodes(node_s *node, bool ascending) {
+  if (node != NULL) {
+    dump_nodes(ascending ? node->left : node->right, ascending);
+    printf("%d ", node->value);
+    dump_nodes(ascending ? node->right : node->left, ascending);
+  }
+}
+
+/**
+ * @brief Prints all values in the binary search tree in a sorted order.
+ *
+ * This function outputs all the values from the binary search tree to the standard output.
+ * The values are displayed in ascending order if `ascending` is true, and in descending order
+ * if `ascending` is false.
+ *
+ * @param tree The binary tree to be dumped.
+ * @param ascending Specifies the order of the output: true for ascending, false for descending.
+ */
+static void scapegoat_dump_tree(binary_tree_s *tree, bool ascending) {
+  if (tree != NULL)
+    dump_nodes(tree->root, ascending);
+  return;
+}
+
+/**
+ * @brief Copies the values of a subtree in ascending order into an array.
+ *
+ * @param node The root of the subtree.
+ * @param array The array receiving the values.
+ * @return The number of values copied.
+ */
+static int nodes_to_array(node_s *node, int *array) {
+  if (node == NULL)
+    return 0;
+  int n = nodes_to_array(node->left, array);
+  array[n++] = node->value;
+  return n + nodes_to_array(node->right, array + n);
+}
+
+/**
+ * @brief Copies all values of the binary search tree in ascending order into an array.
+ *
+ * @param tree The binary tree.
+ * @param array The array receiving the values, large enough for all the values of the tree.
+ * @return The number of values copied.
+ */
+static int scapegoat_binary_tree_to_array(binary_tree_s *tree, int *array) {
+  if (tree == NULL)
+    return 0;
+  return nodes_to_array(tree->root, array);
+}
+
+/**
+ * @brief Removes a node with a specific value from the scapegoat tree if it exists.
+ *
+ * The node is removed as in a naive binary search tree : a node with two children takes the value of
+ * its in-order successor, which is unlinked instead. When the tree holds less than alpha times the
+ * maximal size it reached, the whole tree is rebuilt.
+ *
+ * @param value The value to be removed from the tree.
+ * @param tree The binary tree.
+ * @return The modified tree; NULL if the tree is empty after removal.
+ */
+static binary_tree_s *scapegoat_remove_node(int value, binary_tree_s *tree) {
+  if (tree == NULL)
+    return NULL;
+  node_s **link = &tree->root;
+  while (*link != NULL && BST_COMPARE((*link)->value != value)) {
+    BST_COUNT(visits);
+    link = BST_COMPARE(value < (*link)->value) ? &(*link)->left : &(*link)->right;
+  }
+  if (*link == NULL)
+    return tree; // Value not found
+  node_s *node = *link;
+  if (node->left != NULL && node->right != NULL) {
+    // Node with two children: unlink the inorder successor and keep its value here
+    node_s **successor = &node->right;
+    while ((*successor)->left != NULL) {
+      BST_COUNT(visits);
+      successor = &(*successor)->left;
+    }
+    link = successor;
+    node->value = (*successor)->value;
+    node = *successor;
+  }
+  *link = (node->left != NULL) ? node->left : node->right;
+  free(node);
+  tree->size--;
+  if (tree->size == 0) {
+    free(tree);
+    return NULL;
+  }
+  if (ALPHA_DEN * tree->size < ALPHA_NUM * tree->max_size) {
+    tree->root = rebuild(tree->root, tree->size);
+    tree->max_size = tree->size;
+  }
+  return tree;
+}
+
+/**
+ * @brief Frees the nodes of a subtree.
+ *
+ * @param node The root of the subtree.
+ */
+static void free_nodes(node_s *node) {
+  if (node == NULL)
+    return;
+  free_nodes(node->left);
+  free_nodes(node->right);
+  free(node);
+}
+
+/**
+ * @brief Frees the memory occupied by a binary tree.
+ *
+ * This function frees all nodes of the tree and the tree itself. It safely handles trees that are NULL
+ * by terminating early.
+ *
+ * @param tree Pointer to the binary tree to be freed.
+ */
+static void scapegoat_binary_tree_free(binary_tree_s *tree) {
+  if (tree == NULL)
+    return;
+  free_nodes(tree->root);
+  free(tree);
+}
+
+/**
+ * @brief Operations of the scapegoat tree engine.
+ */
+const bst_ops_t scapegoat_bst_ops = {
+  .name = "scapegoat",
+  .add_node = scapegoat_add_node,
+  .find_node = scapegoat_find_node,
+  .remove_node = scapegoat_remove_node,
+  .binary_tree_height = scapegoat_binary_tree_height,
+  .binary_tree_nodes = scapegoat_binary_tree_nodes,
+  .min_value_node = scapegoat_min_value_node,
+  .dump_tree = scapegoat_dump_tree,
+  .binary_tree_to_array = scapegoat_binary_tree_to_array,
+  .binary_tree_print = scapegoat_binary_tree_print,
+  .binary_tree_free = scapegoat_binary_tree_free,
+  .stats = true,
+};
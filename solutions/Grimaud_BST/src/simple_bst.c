@@ -39,12 +39,12 @@ typedef struct binary_tree {
  * @param tree The root of the binary tree.
  * @return The height of the tree. Returns -1 if the tree is empty.
  */
-int binary_tree_height(binary_tree_s *tree) {
+static int simple_binary_tree_height(binary_tree_s *tree) {
   if(tree==NULL)
     return -1;
   else {
-    int left  = binary_tree_height(tree->left);
-    int right = binary_tree_height(tree->right);
+    int left  = simple_binary_tree_height(tree->left);
+    int right = simple_binary_tree_height(tree->right);
     int max = (left > right) ? left : right;
     return max + 1;
   } 
@@ -58,11 +58,11 @@ int binary_tree_height(binary_tree_s *tree) {
  * @param tree The root of the binary tree.
  * @return The total number of nodes in the tree. Returns 0 if the tree is empty.
  */
-int binary_tree_nodes(binary_tree_s *tree) {
+static int simple_binary_tree_nodes(binary_tree_s *tree) {
   if(tree==NULL)
     return 0;
   else 
-    return binary_tree_nodes(tree->left) + binary_tree_nodes(tree->right) + 1;
+    return simple_binary_tree_nodes(tree->left) + simple_binary_tree_nodes(tree->right) + 1;
 }
 
 /**
@@ -77,7 +77,7 @@ int binary_tree_nodes(binary_tree_s *tree) {
  * @param is_left Flag indicating if the current node is a left child.
  * @param prefix The current prefix for aligning the printed output.
  */
-void binary_tree_print_aux(binary_tree_s *node, int depth, int height, int is_left, char *prefix) {
+static void binary_tree_print_aux(binary_tree_s *node, int depth, int height, int is_left, char *prefix) {
   char new_prefix[200]; // Buffer limited to 200 bytes (<200 characters)
   if (node == NULL || height < 0) return;
   // print right
@@ -112,12 +112,12 @@ void binary_tree_print_aux(binary_tree_s *node, int depth, int height, int is_le
  * 
  * @param tree The root of the binary tree to be printed.
  */
-void binary_tree_print(binary_tree_s *tree) {
-  int height = binary_tree_height(tree);
-  int nodes = binary_tree_nodes(tree);
+static void simple_binary_tree_print(binary_tree_s *tree) {
+  int height = simple_binary_tree_height(tree);
+  int nodes = simple_binary_tree_nodes(tree);
   printf("height : %d  - nodes : %d\n", height, nodes);
-  if (binary_tree_height(tree)>=0) 
-    binary_tree_print_aux(tree, 0, binary_tree_height(tree), 0, "");
+  if (simple_binary_tree_height(tree)>=0) 
+    binary_tree_print_aux(tree, 0, simple_binary_tree_height(tree), 0, "");
   else
     printf("Empty binary tree.\n");
   return;
@@ -132,10 +132,11 @@ void binary_tree_print(binary_tree_s *tree) {
  * @param node The root node of the subtree.
  * @return the minimum value in the given subtree.
  */
-int min_value_node(binary_tree_s *node) {
+static int simple_min_value_node(binary_tree_s *node) {
   assert(node != NULL);
+  BST_COUNT(visits);
   if(node->left!=NULL)
-    return min_value_node(node->left);
+    return simple_min_value_node(node->left);
   return node->value;
 }
 
@@ -150,21 +151,23 @@ int min_value_node(binary_tree_s *node) {
  * @param tree The root of the binary tree (can be NULL if the tree is empty).
  * @return The root of the modified tree.
  */
-binary_tree_s *add_node(int value, binary_tree_s *tree) {
+static binary_tree_s *simple_add_node(int value, binary_tree_s *tree) {
   if(tree==NULL) {
     binary_tree_s *res = malloc(sizeof(binary_tree_s));
     assert(res != NULL);
+    BST_COUNT(allocations);
     res->value = value;
     res->left = res->right = NULL;
     return res;
   }
-  if(tree->value == value) {
+  BST_COUNT(visits);
+  if(BST_COMPARE(tree->value == value)) {
     return tree;
   }
-  if(tree->value > value) {
-    tree->left = add_node(value, tree->left);
+  if(BST_COMPARE(tree->value > value)) {
+    tree->left = simple_add_node(value, tree->left);
   } else {
-    tree->right = add_node(value, tree->right);
+    tree->right = simple_add_node(value, tree->right);
   }
   return tree;
 }
@@ -179,14 +182,15 @@ binary_tree_s *add_node(int value, binary_tree_s *tree) {
  * @param tree The root of the binary tree.
  * @return true if the value is found, false otherwise.
  */
-bool find_node(int value, binary_tree_s *tree) {
+static bool simple_find_node(int value, binary_tree_s *tree) {
   if(tree==NULL)
     return false;
-  if(tree->value==value)
+  BST_COUNT(visits);
+  if(BST_COMPARE(tree->value==value))
     return true;
-  if(tree->value < value) 
-    return find_node(value, tree->right);
-  return find_node(value, tree->left);
+  if(BST_COMPARE(tree->value < value))
+    return simple_find_node(value, tree->right);
+  return simple_find_node(value, tree->left);
 }
 
 /**
@@ -200,26 +204,41 @@ bool find_node(int value, binary_tree_s *tree) {
  * @param tree The root node of the binary tree to be dumped.
  * @param ascending Specifies the order of the output: true for ascending, false for descending.
  */
-void dump_tree(binary_tree_s *tree, bool ascending) {
+static void simple_dump_tree(binary_tree_s *tree, bool ascending) {
   if(tree != NULL){
     if(ascending){
       // Ascending to boolean
       if (tree->left != NULL)
-	dump_tree(tree->left,ascending);
+	simple_dump_tree(tree->left,ascending);
       printf("%d ",tree->value);
       if (tree->right != NULL)
-	dump_tree(tree->right,ascending);
+	simple_dump_tree(tree->right,ascending);
     } else {
       if (tree->right != NULL)
-	dump_tree(tree->right,ascending);
+	simple_dump_tree(tree->right,ascending);
       printf("%d ",tree->value);     
       if (tree->left != NULL)
-	dump_tree(tree->left,ascending);
+	simple_dump_tree(tree->left,ascending);
     }
   }
   return;
 }   
 
+/**
+ * @brief Copies all values of the binary search tree in ascending order into an array.
+ *
+ * @param tree The root node of the binary tree.
+ * @param array The array receiving the values, large enough for all the values of the tree.
+ * @return The number of values copied.
+ */
+static int simple_binary_tree_to_array(binary_tree_s *tree, int *array) {
+  if(tree==NULL)
+    return 0;
+  int n = simple_binary_tree_to_array(tree->left, array);
+  array[n++] = tree->value;
+  return n + simple_binary_tree_to_array(tree->right, array + n);
+}
+
 
 /**
  * @brief Removes a node with a specific value from the binary tree if it exists.
@@ -233,15 +252,16 @@ void dump_tree(binary_tree_s *tree, bool ascending) {
  * @param tree The root of the binary tree.
  * @return The root of the modified tree; NULL if the tree is empty after removal.
  */
-binary_tree_s *remove_node(int value, binary_tree_s *tree) {
+static binary_tree_s *simple_remove_node(int value, binary_tree_s *tree) {
   if (tree == NULL) {
     return NULL; // Value not found, return NULL
   }
   // Navigate the tree and recurse down to find the node
-  if (value < tree->value) {
-    tree->left = remove_node(value, tree->left);
-  } else if (value > tree->value) {
-    tree->right = remove_node(value, tree->right);
+  BST_COUNT(visits);
+  if (BST_COMPARE(value < tree->value)) {
+    tree->left = simple_remove_node(value, tree->left);
+  } else if (BST_COMPARE(value > tree->value)) {
+    tree->right = simple_remove_node(value, tree->right);
   } else {
     // Node with only one child or no child
     if (tree->left == NULL) {
@@ -254,11 +274,11 @@ binary_tree_s *remove_node(int value, binary_tree_s *tree) {
       return temp;
     }
     // Node with two children: Get the inorder successor (smallest in the right subtree)
-    int temp_value = min_value_node(tree->right);
+    int temp_value = simple_min_value_node(tree->right);
     // Copy the inorder successor's content to this node
     tree->value = temp_value;
     // Delete the inorder successor
-    tree->right = remove_node(temp_value, tree->right);
+    tree->right = simple_remove_node(temp_value, tree->right);
   }
   return tree;
 }
@@ -271,12 +291,30 @@ binary_tree_s *remove_node(int value, binary_tree_s *tree) {
  *
  * @param tree Pointer to the root of the binary tree to be freed.
  */
-void binary_tree_free(binary_tree_s *tree) {
+static void simple_binary_tree_free(binary_tree_s *tree) {
   if(tree==NULL)
     return;
   if(tree->left != NULL)
-    binary_tree_free(tree->left);
+    simple_binary_tree_free(tree->left);
   if(tree->right !=NULL)
-    binary_tree_free(tree->right);
+    simple_binary_tree_free(tree->right);
   free(tree);
 }
+
+/**
+ * @brief Operations of the simple (unbalanced) binary search tree engine.
+ */
+const bst_ops_t simple_bst_ops = {
+  .name = "simple",
+  .add_node = simple_add_node,
+  .find_node = simple_find_node,
+  .remove_node = simple_remove_node,
+  .binary_tree_height = simple_binary_tree_height,
+  .binary_tree_nodes = simple_binary_tree_nodes,
+  .min_value_node = simple_min_value_node,
+  .dump_tree = simple_dump_tree,
+  .binary_tree_to_array = simple_binary_tree_to_array,
+  .binary_tree_print = simple_binary_tree_print,
+  .binary_tree_free = simple_binary_tree_free,
+  .stats = true,
+};
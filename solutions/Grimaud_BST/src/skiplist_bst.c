@@ -0,0 +1,381 @@
+/**
+ * @file skiplist_bst.c
+ * @brief Implementation of the binary search tree operations in C using a skip list.
+ *
+ * This file contains an implementation of the ordered set operations of bst.h on a skip list (Pugh) :
+ * the values are kept in a sorted linked list, and each node also belongs to a random number of express
+ * lists, a node being in the level k+1 with probability 1/4 when it is in the level k. A search starts in
+ * the highest level and goes down each time the next value is too large, in expected O(log n) steps.
+ * The nodes are allocated in contiguous chunks owned by the list, each twice as large as the previous
+ * one up to 64 KiB, and the removed nodes are kept in per-level free lists to be reused by the next
+ * insertions.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "bst.h"
+
+/**
+ * @brief Maximal number of levels of the skip list (enough for 4^16 values with a 1/4 probability).
+ */
+#define MAX_LEVEL 16
+
+/**
+ * @brief Size in bytes of the first chunk of the node arena, enough for a node of MAX_LEVEL levels.
+ */
+#define CHUNK_MIN_SIZE 256
+
+/**
+ * @brief Maximal size in bytes of the chunks of the node arena, each chunk doubling the previous one.
+ */
+#define CHUNK_SIZE 65536
+
+/**
+ * @struct skip_node_s
+ * @brief A structure to represent a node of the skip list.
+ *
+ * The node holds its value and one forward pointer for each level it belongs to.
+ */
+typedef struct skip_node {
+  int value;                         /**< The value of the node */
+  int level;                         /**< The number of levels the node belongs to */
+  struct skip_node *next[];          /**< The next node in each level */
+} skip_node_s;
+
+/**
+ * @struct chunk_s
+ * @brief A contiguous block of memory of the node arena.
+ */
+typedef struct chunk {
+  struct chunk *next;                /**< The previously allocated chunk */
+  size_t capacity;                   /**< The number of bytes of data */
+  size_t used;                       /**< The number of bytes already given to nodes */
+  char data[];                       /**< The memory given to the nodes */
+} chunk_s;
+
+/**
+ * @struct binary_tree_s
+ * @brief A structure to represent a skip list.
+ *
+ * An empty skip list is represented by NULL.
+ */
+typedef struct binary_tree {
+  skip_node_s *head[MAX_LEVEL];      /**< The first node in each level */
+  int level;                         /**< The number of levels in use */
+  int size;                          /**< The number of values in the list */
+  uint32_t seed;                     /**< State of the pseudo-random generator of the levels */
+  skip_node_s *free_nodes[MAX_LEVEL];/**< The removed nodes, by level, chained by their first pointer */
+  chunk_s *chunks;                   /**< The chunks of the node arena */
+} binary_tree_s;
+
+/**
+ * @brief Draws the number of levels of a new node, following a geometric law of parameter 3/4.
+ *
+ * @param tree The skip list.
+ * @return A level between 1 and MAX_LEVEL.
+ */
+static int random_level(binary_tree_s *tree) {
+  uint32_t x = tree->seed; // xorshift32 (Marsaglia)
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  tree->seed = x;
+  int level = 1;
+  while (level < MAX_LEVEL && (x & 3) == 0) {
+    level++;
+    x >>= 2;
+  }
+  return level;
+}
+
+/**
+ * @brief Gives memory for a new node, from the free lists or from the arena.
+ *
+ * @param tree The skip list.
+ * @param level The number of levels of the node.
+ * @return The new node, whose value and pointers are not initialized.
+ */
+static skip_node_s *node_alloc(binary_tree_s *tree, int level) {
+  BST_COUNT(allocations);
+  skip_node_s *node = tree->free_nodes[level - 1];
+  if (node != NULL) {
+    tree->free_nodes[level - 1] = node->next[0];
+    return node;
+  }
+  size_t size = sizeof(skip_node_s) + level * sizeof(skip_node_s *);
+  size = (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+  if (tree->chunks == NULL || tree->chunks->used + size > tree->chunks->capacity) {
+    // Small lists only take a small chunk, larger ones get chunks twice as large up to CHUNK_SIZE
+    size_t capacity = (tree->chunks == NULL) ? CHUNK_MIN_SIZE : 2 * tree->chunks->capacity;
+    if (capacity > CHUNK_SIZE)
+      capacity = CHUNK_SIZE;
+    chunk_s *chunk = malloc(sizeof(chunk_s) + capacity);
+    assert(chunk != NULL);
+    chunk->next = tree->chunks;
+    chunk->capacity = capacity;
+    chunk->used = 0;
+    tree->chunks = chunk;
+  }
+  node = (skip_node_s *)(tree->chunks->data + tree->chunks->used);
+  tree->chunks->used += size;
+  node->level = level;
+  return node;
+}
+
+/**
+ * @brief Calculates the height of the skip list, i.e. its number of levels minus one.
+ *
+ * @param tree The skip list.
+ * @return The height of the list. Returns -1 if the list is empty.
+ */
+static int skiplist_binary_tree_height(binary_tree_s *tree) {
+  if (tree == NULL)
+    return -1;
+  return tree->level - 1;
+}
+
+/**
+ * @brief Counts the number of values in the skip list.
+ *
+ * @param tree The skip list.
+ * @return The number of values. Returns 0 if the list is empty.
+ */
+static int skiplist_binary_tree_nodes(binary_tree_s *tree) {
+  if (tree == NULL)
+    return 0;
+  return tree->size;
+}
+
+/**
+ * @brief Prints the skip list, one line per level from the highest one.
+ *
+ * Each value is printed in the column of its node, on each level the node belongs to.
+ *
+ * @param tree The skip list to be printed.
+ */
+static void skiplist_binary_tree_print(binary_tree_s *tree) {
+  int height = skiplist_binary_tree_height(tree);
+  int nodes = skiplist_binary_tree_nodes(tree);
+  printf("height : %d  - nodes : %d\n", height, nodes);
+  if (height < 0) {
+    printf("Empty binary tree.\n");
+    return;
+  }
+  for (int level = height; level >= 0; level--) {
+    printf("[%02d] ", level);
+    for (skip_node_s *node = tree->head[0]; node != NULL; node = node->next[0]) {
+      if (node->level > level)
+        printf("─(%04d)", node->value);
+      else
+        printf("───────");
+    }
+    printf("─┤\n");
+  }
+  return;
+}
+
+/**
+ * @brief Find the minimum value in the skip list.
+ *
+ * @param tree The skip list, which must not be empty.
+ * @return the minimum value, i.e. the value of the first node.
+ */
+static int skiplist_min_value_node(binary_tree_s *tree) {
+  assert(tree != NULL);
+  return tree->head[0]->value;
+}
+
+/**
+ * @brief Searches the forward pointers which precede a value in each level.
+ *
+ * @param tree The skip list.
+ * @param value The value searched.
+ * @param update Output : for each level in use, the address of the last forward pointer before the value.
+ * @return The first node whose value is greater or equal to the value, NULL if there is none.
+ */
+static skip_node_s *search(binary_tree_s *tree, int value, skip_node_s ***update) {
+  skip_node_s **forward = tree->head;
+  for (int level = tree->level - 1; level >= 0; level--) {
+    while (forward[level] != NULL && BST_COMPARE(forward[level]->value < value)) {
+      BST_COUNT(visits);
+      forward = forward[level]->next;
+    }
+    update[level] = &forward[level];
+  }
+  return forward[0];
+}
+
+/**
+ * @brief Adds a value to the skip list.
+ *
+ * The new node receives a random number of levels, and is linked after the last node lower than
+ * the value in each of these levels. If the value already exists in the list, the list is returned
+ * unchanged.
+ *
+ * @param value The value to be added.
+ * @param tree The skip list (can be NULL if the list is empty).
+ * @return The modified skip list.
+ */
+static binary_tree_s *skiplist_add_node(int value, binary_tree_s *tree) {
+  if (tree == NULL) {
+    tree = calloc(1, sizeof(binary_tree_s));
+    assert(tree != NULL);
+    tree->seed = 2463534242u;
+  }
+  skip_node_s **update[MAX_LEVEL];
+  skip_node_s *next = search(tree, value, update);
+  if (next != NULL && BST_COMPARE(next->value == value))
+    return tree;
+  int level = random_level(tree);
+  for (; tree->level < level; tree->level++)
+    update[tree->level] = &tree->head[tree->level];
+  skip_node_s *node = node_alloc(tree, level);
+  node->value = value;
+  for (int i = 0; i < level; i++) {
+    node->next[i] = *update[i];
+    *update[i] = node;
+  }
+  tree->size++;
+  return tree;
+}
+
+/**
+ * @brief Checks whether a value exists in the skip list.
+ *
+ * @param value The value to search for.
+ * @param tree The skip list.
+ * @return true if the value is found, false otherwise.
+ */
+static bool skiplist_find_node(int value, binary_tree_s *tree) {
+  if (tree == NULL)
+    return false;
+  skip_node_s **forward = tree->head;
+  for (int level = tree->level - 1; level >= 0; level--) {
+    while (forward[level] != NULL && BST_COMPARE(forward[level]->value < value)) {
+      BST_COUNT(visits);
+      forward = forward[level]->next;
+    }
+  }
+  return forward[0] != NULL && BST_COMPARE(forward[0]->value == value);
+}
+
+/**
+ * @brief Prints all values in the skip list in a sorted order.
+ *
+ * The values are displayed in ascending order if `ascending` is true, and in descending order if
+ * `ascending` is false. As the list is only linked forward, the descending order goes through a
+ * temporary array.
+ *
+ * @param tree The skip list to be dumped.
+ * @param ascending Specifies the order of the output: true for ascending, false for descending.
+ */
+static void skiplist_dump_tree(binary_tree_s *tree, bool ascending) {
+  if (tree == NULL)
+    return;
+  if (ascending) {
+    for (skip_node_s *node = tree->head[0]; node != NULL; node = node->next[0])
+      printf("%d ", node->value);
+  } else {
+    int *values = malloc(tree->size * sizeof(int));
+    assert(values != NULL);
+    int n = 0;
+    for (skip_node_s *node = tree->head[0]; node != NULL; node = node->next[0])
+      values[n++] = node->value;
+    while (n > 0)
+      printf("%d ", values[--n]);
+    free(values);
+  }
+  return;
+}
+
+/**
+ * @brief Copies all values of the skip list in ascending order into an array.
+ *
+ * @param tree The skip list.
+ * @param array The array receiving the values, large enough for all the values of the list.
+ * @return The number of values copied.
+ */
+static int skiplist_binary_tree_to_array(binary_tree_s *tree, int *array) {
+  int n = 0;
+  if (tree != NULL)
+    for (skip_node_s *node = tree->head[0]; node != NULL; node = node->next[0])
+      array[n++] = node->value;
+  return n;
+}
+
+static void skiplist_binary_tree_free(binary_tree_s *tree);
+
+/**
+ * @brief Removes a value from the skip list if it exists.
+ *
+ * The node is unlinked from each of its levels and kept for a later insertion. The unused top
+ * levels are then dropped.
+ *
+ * @param value The value to be removed.
+ * @param tree The skip list.
+ * @return The modified skip list; NULL if the list is empty after removal.
+ */
+static binary_tree_s *skiplist_remove_node(int value, binary_tree_s *tree) {
+  if (tree == NULL)
+    return NULL;
+  skip_node_s **update[MAX_LEVEL];
+  skip_node_s *node = search(tree, value, update);
+  if (node == NULL || BST_COMPARE(node->value != value))
+    return tree; // Value not found
+  for (int i = 0; i < node->level; i++)
+    *update[i] = node->next[i];
+  node->next[0] = tree->free_nodes[node->level - 1];
+  tree->free_nodes[node->level - 1] = node;
+  while (tree->level > 0 && tree->head[tree->level - 1] == NULL)
+    tree->level--;
+  tree->size--;
+  if (tree->size == 0) {
+    skiplist_binary_tree_free(tree);
+    return NULL;
+  }
+  return tree;
+}
+
+/**
+ * @brief Frees the memory occupied by a skip list.
+ *
+ * The nodes are released with the chunks of the arena. It safely handles lists that are NULL.
+ *
+ * @param tree Pointer to the skip list to be freed.
+ */
+static void skiplist_binary_tree_free(binary_tree_s *tree) {
+  if (tree == NULL)
+    return;
+  while (tree->chunks != NULL) {
+    chunk_s *chunk = tree->chunks;
+    tree->chunks = chunk->next;
+    free(chunk);
+  }
+  free(tree);
+}
+
+/**
+ * @brief Operations of the skip list engine.
+ */
+const bst_ops_t skiplist_bst_ops = {
+  .name = "skiplist",
+  .add_node = skiplist_add_node,
+  .find_node = skiplist_find_node,
+  .remove_node = skiplist_remove_node,
+  .binary_tree_height = skiplist_binary_tree_height,
+  .binary_tree_nodes = skiplist_binary_tree_nodes,
+  .min_value_node = skiplist_min_value_node,
+  .dump_tree = skiplist_dump_tree,
+  .binary_tree_to_array = skiplist_binary_tree_to_array,
+  .binary_tree_print = skiplist_binary_tree_print,
+  .binary_tree_free = skiplist_binary_tree_free,
+  .stats = true,
+};
@@ -0,0 +1,156 @@
+/**
+ * @file topk.c
+ * @brief Implementation of the streaming top-k of topk.h.
+ *
+ * The k largest values are kept in a 4-ary min-heap of heap_template.h, and the k smallest ones in a
+ * 4-ary max-heap, so that the top is always the threshold. Sorting the copy of the heap with the same
+ * heap puts the top (the worst value) last, hence the best values first in both cases.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "topk.h"
+#include "heap_template.h"
+
+/**
+ * @brief Number of values compared with the threshold at once by topk_push_batch().
+ */
+#define TOPK_BLOCK 16
+
+/*
+ * Min-heap of the k largest values and max-heap of the k smallest ones.
+ */
+HEAP_DEFINE(largest_heap, int, HEAP_MIN, 4)
+HEAP_DEFINE(smallest_heap, int, HEAP_MAX, 4)
+
+/**
+ * @struct topk
+ * @brief Structure of the top-k.
+ */
+typedef struct topk {
+  int *array;       /**< The heap of the values kept, allocated for k values */
+  size_t size;      /**< Number of values kept */
+  size_t k;         /**< Number of values to keep */
+  bool largest;     /**< Whether the largest values are kept, rather than the smallest ones */
+} topk_t;
+
+/**
+ * @brief Tests whether a value is better than the threshold of a full top-k.
+ * @param topk The top-k.
+ * @param value The value.
+ * @return true if the value must replace the threshold.
+ */
+static inline bool better(topk_t *topk, int value) {
+  return topk->largest ? value > topk->array[0] : value < topk->array[0];
+}
+
+/**
+ * @brief Adds a value to a top-k which is not full, or replaces its threshold by a better value.
+ * @param topk The top-k.
+ * @param value The value.
+ */
+static void keep(topk_t *topk, int value) {
+  if (topk->size < topk->k) {
+    if (topk->largest)
+      largest_heap_sift_up(topk->array, topk->size, value);
+    else
+      smallest_heap_sift_up(topk->array, topk->size, value);
+    topk->size++;
+  } else {
+    topk->array[0] = value;
+    if (topk->largest)
+      largest_heap_sift_down(topk->array, topk->size, 0);
+    else
+      smallest_heap_sift_down(topk->array, topk->size, 0);
+  }
+}
+
+/**
+ * @brief Tests whether a block of values holds one better than a threshold.
+ *
+ * There is no early exit, so that the loop is vectorized.
+ * @param values The TOPK_BLOCK values of the block.
+ * @param threshold The threshold.
+ * @param largest Whether the larger values are the better ones.
+ * @return true if a value of the block is better than the threshold.
+ */
+static inline bool block_has_better(const int *values, int threshold, bool largest) {
+  int any = 0;
+  if (largest)
+    for (int j = 0; j < TOPK_BLOCK; j++)
+      any |= values[j] > threshold;
+  else
+    for (int j = 0; j < TOPK_BLOCK; j++)
+      any |= values[j] < threshold;
+  return any != 0;
+}
+
+/*
+ * The functions of topk.h are documented in the header.
+ */
+
+topk_t *topk_create(size_t k, bool largest) {
+  topk_t *res = malloc(sizeof(topk_t));
+  assert(res != NULL);
+  res->array = NULL;
+  if (k > 0) {
+    res->array = malloc(k * sizeof(int));
+    assert(res->array != NULL);
+  }
+  res->size = 0;
+  res->k = k;
+  res->largest = largest;
+  return res;
+}
+
+size_t topk_size(topk_t *topk) {
+  assert(topk != NULL);
+  return topk->size;
+}
+
+void topk_push(topk_t *topk, int value) {
+  assert(topk != NULL);
+  if (topk->size < topk->k || (topk->k > 0 && better(topk, value)))
+    keep(topk, value);
+}
+
+void topk_push_batch(topk_t *topk, const int *values, size_t n) {
+  assert(topk != NULL && (values != NULL || n == 0));
+  if (topk->k == 0)
+    return;
+  size_t i = 0;
+  for (; i < n && topk->size < topk->k; i++) // until the top-k is full
+    keep(topk, values[i]);
+  for (; i + TOPK_BLOCK <= n; i += TOPK_BLOCK)
+    if (block_has_better(values + i, topk->array[0], topk->largest))
+      for (int j = 0; j < TOPK_BLOCK; j++)
+        if (better(topk, values[i + j]))
+          keep(topk, values[i + j]);
+  for (; i < n; i++)
+    if (better(topk, values[i]))
+      keep(topk, values[i]);
+}
+
+size_t topk_result(topk_t *topk, int *result) {
+  assert(topk != NULL && (result != NULL || topk->size == 0));
+  if (topk->size == 0)
+    return 0;
+  memcpy(result, topk->array, topk->size * sizeof(int));
+  if (topk->largest)
+    largest_heap_sort(result, topk->size);
+  else
+    smallest_heap_sort(result, topk->size);
+  return topk->size;
+}
+
+void topk_delete(topk_t *topk) {
+  assert(topk != NULL);
+  free(topk->array);
+  free(topk);
+}
@@ -0,0 +1,375 @@
+/**
+ * @file treap_bst.c
+ * @brief Implementation of a binary search tree in C using a randomized treap.
+ *
+ * This file contains the implementation of a treap, i.e. a binary search tree on the values that is
+ * also a max-heap on random priorities drawn when the nodes are created. Insertion and removal are
+ * written with the split and merge operations instead of rotations : the expected depth of the tree is
+ * O(log n) whatever the order of the insertions, and each node only stores one priority word on top
+ * of the value and the two children.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "bst.h"
+
+/**
+ * @struct binary_tree_s
+ * @brief A structure to represent a node in a treap.
+ *
+ * This structure holds the value of the node, its random priority and pointers to the left and
+ * right child nodes. The priority of a node is never lower than the priorities of its children.
+ */
+typedef struct binary_tree {
+  int value;                         /**< The value of the node */
+  uint32_t priority;                 /**< The random priority of the node (heap order) */
+  struct binary_tree *left;          /**< Pointer to the left child */
+  struct binary_tree *right;         /**< Pointer to the right child */
+} binary_tree_s;
+
+/**
+ * @brief State of the xorshift pseudo-random generator used for the priorities.
+ *
+ * The seed is fixed so that a given sequence of commands always builds the same tree.
+ */
+static uint32_t treap_seed = 2463534242u;
+
+/**
+ * @brief Draws a new priority with the xorshift32 generator (Marsaglia).
+ *
+ * @return A pseudo-random 32 bits priority.
+ */
+static uint32_t treap_random(void) {
+  uint32_t x = treap_seed;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  treap_seed = x;
+  return x;
+}
+
+/**
+ * @brief Calculates the height of the binary tree.
+ *
+ * This function determines the height of the binary tree recursively. The height of a tree is the number of edges
+ * along the longest path from the root down to the farthest leaf node.
+ *
+ * @param tree The root of the binary tree.
+ * @return The height of the tree. Returns -1 if the tree is empty.
+ */
+static int treap_binary_tree_height(binary_tree_s *tree) {
+  if(tree==NULL)
+    return -1;
+  else {
+    int left  = treap_binary_tree_height(tree->left);
+    int right = treap_binary_tree_height(tree->right);
+    int max = (left > right) ? left : right;
+    return max + 1;
+  }
+}
+
+/**
+ * @brief Counts the total number of nodes in the binary tree.
+ *
+ * This function recursively calculates the total number of nodes in the binary tree.
+ *
+ * @param tree The root of the binary tree.
+ * @return The total number of nodes in the tree. Returns 0 if the tree is empty.
+ */
+static int treap_binary_tree_nodes(binary_tree_s *tree) {
+  if(tree==NULL)
+    return 0;
+  else
+    return treap_binary_tree_nodes(tree->left) + treap_binary_tree_nodes(tree->right) + 1;
+}
+
+/**
+ * @brief Internal helper function to print the binary tree.
+ *
+ * This recursive function assists in printing the binary tree in a structured ASCII art format.
+ * The function utilizes depth to determine the prefixes and branching structure for each node.
+ * The most significant byte of the priority of each node is printed next to its value.
+ *
+ * @param node The current node being printed.
+ * @param depth The current depth in the tree.
+ * @param height The height of the tree.
+ * @param is_left Flag indicating if the current node is a left child.
+ * @param prefix The current prefix for aligning the printed output.
+ */
+static void binary_tree_print_aux(binary_tree_s *node, int depth, int height, int is_left, char *prefix) {
+  char new_prefix[200]; // Buffer limited to 200 bytes (<200 characters)
+  if (node == NULL) return;
+  // print right
+  if (node->right != NULL) {
+    char *s1 = (is_left) ? "│" : " ";
+    char *s2 = (is_left) ? " " : "│";
+    snprintf(new_prefix, sizeof(new_prefix), "%s%s          ", prefix, s1);
+    binary_tree_print_aux(node->right, depth + 1, height, 0, new_prefix);
+    snprintf(new_prefix, sizeof(new_prefix), "%s%s          ", prefix, s2);
+  }
+  // print node
+  printf("%s", prefix);
+  char *s1 = (depth) ? ((is_left) ? "└" : "┌") : " ";
+  char *s2 = (depth >= height) ? " " : ((node->left) ? ((node->right) ? "┤" : "┐") : ((node->right) ? "┘" : " "));
+  printf("%s(%04d)[%02x]%s\n", s1, node->value, node->priority >> 24, s2);
+  // print left
+  if (node->left != NULL) {
+    char *s1 = (depth) ? ((is_left) ? " " : "│") : " ";
+    char *s2 = (depth) ? ((is_left) ? "│" : " ") : " ";
+    snprintf(new_prefix, sizeof(new_prefix), "%s%s          ", prefix, s1);
+    binary_tree_print_aux(node->left, depth + 1, height, 1, new_prefix);
+    snprintf(new_prefix, sizeof(new_prefix), "%s%s          ", prefix, s2);
+  }
+  return;
+}
+
+/**
+ * @brief Public function to print the entire binary tree.
+ *
+ * This function prints the binary tree starting from the root. It displays the tree's height and number of nodes
+ * before printing the tree structure.
+ *
+ * @param tree The root of the binary tree to be printed.
+ */
+static void treap_binary_tree_print(binary_tree_s *tree) {
+  int height = treap_binary_tree_height(tree);
+  int nodes = treap_binary_tree_nodes(tree);
+  printf("height : %d  - nodes : %d\n", height, nodes);
+  if (height>=0)
+    binary_tree_print_aux(tree, 0, height, 0, "");
+  else
+    printf("Empty binary tree.\n");
+  return;
+}
+
+/**
+ * @brief Find the node with the minimum value in a binary search tree.
+ *
+ * This helper function is used to find the in-order successor, i.e., the smallest node
+ * in the given binary tree rooted at the specified node.
+ *
+ * @param node The root node of the subtree.
+ * @return the minimum value in the given subtree.
+ */
+static int treap_min_value_node(binary_tree_s *node) {
+  assert(node != NULL);
+  BST_COUNT(visits);
+  while(node->left!=NULL) {
+    node = node->left;
+    BST_COUNT(visits);
+  }
+  return node->value;
+}
+
+/**
+ * @brief Splits a treap into the values lower and the values greater than a given value.
+ *
+ * The value must not be present in the treap. Both resulting treaps keep the heap order of the
+ * priorities, as the split only cuts the search path of the value.
+ *
+ * @param tree The root of the treap to split (consumed by the operation).
+ * @param value The value used as the split point.
+ * @param lower Output : the treap holding the values lower than value.
+ * @param greater Output : the treap holding the values greater than value.
+ */
+static void treap_split(binary_tree_s *tree, int value, binary_tree_s **lower, binary_tree_s **greater) {
+  if (tree == NULL) {
+    *lower = *greater = NULL;
+    return;
+  }
+  BST_COUNT(visits);
+  BST_COUNT(rotations); // a node relinked by the split, as by a rotation of the new node up to it
+  if (BST_COMPARE(tree->value < value)) {
+    treap_split(tree->right, value, &tree->right, greater);
+    *lower = tree;
+  } else {
+    treap_split(tree->left, value, lower, &tree->left);
+    *greater = tree;
+  }
+}
+
+/**
+ * @brief Merges two treaps, all the values of the first one being lower than those of the second one.
+ *
+ * The root of the result is the root with the highest priority, so the heap order is preserved.
+ *
+ * @param lower The treap holding the lower values.
+ * @param greater The treap holding the greater values.
+ * @return The root of the merged treap.
+ */
+static binary_tree_s *treap_merge(binary_tree_s *lower, binary_tree_s *greater) {
+  if (lower == NULL)
+    return greater;
+  if (greater == NULL)
+    return lower;
+  BST_COUNT(rotations); // a node relinked by the merge, as by a rotation of the removed node down
+  if (lower->priority > greater->priority) {
+    lower->right = treap_merge(lower->right, greater);
+    return lower;
+  }
+  greater->left = treap_merge(lower, greater->left);
+  return greater;
+}
+
+static bool treap_find_node(int value, binary_tree_s *tree);
+
+/**
+ * @brief Adds a node with a specific value to the treap.
+ *
+ * A priority is drawn for the value, then the search path of the value is followed while the nodes
+ * have higher priorities. The subtree found at this point is split around the value and its two parts
+ * become the children of the new node. If the value already exists in the tree, the tree is returned
+ * unchanged.
+ *
+ * @param value The value to be added to the tree.
+ * @param tree The root of the binary tree (can be NULL if the tree is empty).
+ * @return The root of the modified tree.
+ */
+static binary_tree_s *treap_add_node(int value, binary_tree_s *tree) {
+  uint32_t priority = treap_random();
+  binary_tree_s **link = &tree;
+  while (*link != NULL && (*link)->priority >= priority) {
+    BST_COUNT(visits);
+    if (BST_COMPARE((*link)->value == value))
+      return tree;
+    link = BST_COMPARE(value < (*link)->value) ? &(*link)->left : &(*link)->right;
+  }
+  // The value may still lie in the subtree which is going to be split
+  if (treap_find_node(value, *link))
+    return tree;
+  binary_tree_s *res = malloc(sizeof(binary_tree_s));
+  assert(res != NULL);
+  BST_COUNT(allocations);
+  res->value = value;
+  res->priority = priority;
+  treap_split(*link, value, &res->left, &res->right);
+  *link = res;
+  return tree;
+}
+
+/**
+ * @brief Searches for a node with a specific value in the binary tree.
+ *
+ * This function checks if the tree contains a node with the specified value using a binary search approach.
+ * It returns true if the value is found and false otherwise.
+ *
+ * @param value The value to search for in the tree.
+ * @param tree The root of the binary tree.
+ * @return true if the value is found, false otherwise.
+ */
+static bool treap_find_node(int value, binary_tree_s *tree) {
+  while (tree != NULL) {
+    BST_COUNT(visits);
+    if (BST_COMPARE(tree->value == value))
+      return true;
+    tree = BST_COMPARE(tree->value < value) ? tree->right : tree->left;
+  }
+  return false;
+}
+
+/**
+ * @brief Prints all values in the binary search tree in a sorted order.
+ *
+ * This function outputs all the values from the binary search tree rooted at the specified node
+ * to the standard output. The values are displayed in ascending order if `ascending` is true,
+ * and in descending order if `ascending` is false. This is useful for debugging or visual verification
+ * of tree contents.
+ *
+ * @param tree The root node of the binary tree to be dumped.
+ * @param ascending Specifies the order of the output: true for ascending, false for descending.
+ */
+static void treap_dump_tree(binary_tree_s *tree, bool ascending) {
+  if(tree != NULL){
+    if(ascending){
+      treap_dump_tree(tree->left,ascending);
+      printf("%d ",tree->value);
+      treap_dump_tree(tree->right,ascending);
+    } else {
+      treap_dump_tree(tree->right,ascending);
+      printf("%d ",tree->value);
+      treap_dump_tree(tree->left,ascending);
+    }
+  }
+  return;
+}
+
+/**
+ * @brief Copies all values of the binary search tree in ascending order into an array.
+ *
+ * @param tree The root node of the binary tree.
+ * @param array The array receiving the values, large enough for all the values of the tree.
+ * @return The number of values copied.
+ */
+static int treap_binary_tree_to_array(binary_tree_s *tree, int *array) {
+  if(tree==NULL)
+    return 0;
+  int n = treap_binary_tree_to_array(tree->left, array);
+  array[n++] = tree->value;
+  return n + treap_binary_tree_to_array(tree->right, array + n);
+}
+
+/**
+ * @brief Removes a node with a specific value from the treap if it exists.
+ *
+ * The node holding the value is replaced by the merge of its two subtrees, so no rotation
+ * and no successor copy are needed.
+ *
+ * @param value The value to be removed from the tree.
+ * @param tree The root of the binary tree.
+ * @return The root of the modified tree; NULL if the tree is empty after removal.
+ */
+static binary_tree_s *treap_remove_node(int value, binary_tree_s *tree) {
+  binary_tree_s **link = &tree;
+  while (*link != NULL && BST_COMPARE((*link)->value != value)) {
+    BST_COUNT(visits);
+    link = BST_COMPARE(value < (*link)->value) ? &(*link)->left : &(*link)->right;
+  }
+  if (*link != NULL) {
+    binary_tree_s *node = *link;
+    *link = treap_merge(node->left, node->right);
+    free(node);
+  }
+  return tree;
+}
+
+/**
+ * @brief Frees the memory occupied by a binary tree.
+ *
+ * This function recursively frees all nodes of a binary tree, starting from the leaves
+ * towards the root. It safely handles trees that are NULL by terminating early.
+ *
+ * @param tree Pointer to the root of the binary tree to be freed.
+ */
+static void treap_binary_tree_free(binary_tree_s *tree) {
+  if(tree==NULL)
+    return;
+  treap_binary_tree_free(tree->left);
+  treap_binary_tree_free(tree->right);
+  free(tree);
+}
+
+/**
+ * @brief Operations of the treap engine.
+ */
+const bst_ops_t treap_bst_ops = {
+  .name = "treap",
+  .add_node = treap_add_node,
+  .find_node = treap_find_node,
+  .remove_node = treap_remove_node,
+  .binary_tree_height = treap_binary_tree_height,
+  .binary_tree_nodes = treap_binary_tree_nodes,
+  .min_value_node = treap_min_value_node,
+  .dump_tree = treap_dump_tree,
+  .binary_tree_to_array = treap_binary_tree_to_array,
+  .binary_tree_print = treap_binary_tree_print,
+  .binary_tree_free = treap_binary_tree_free,
+  .stats = true,
+};
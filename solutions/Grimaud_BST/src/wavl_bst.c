@@ -0,0 +1,485 @@
+/**
+ * @file wavl_bst.c
+ * @brief Implementation of a binary search tree in C using a weak AVL (rank-balanced) tree.
+ *
+ * This file contains the implementation of a weak AVL tree (Haeupler, Sen and Tarjan). Each node stores
+ * a rank, and the rank difference between a node and each of its children (a missing child having the
+ * rank -1) is 1 or 2, the leaves having the rank 0. Without removal, a weak AVL tree is an AVL tree.
+ * The rebalancing after an insertion or a removal performs at most two rotations, and the number of
+ * rank changes is O(1) amortized, whereas the AVL removal may rotate at each level of the search path.
+ * The churn of bst_bench (bin/stats_bst_bench --churn) compares its rotations and cache misses with
+ * the AVL and red-black trees under removals.
+ *
+ * @author Grimaud
+ * @date 04/15/2024
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include "bst.h"
+
+/**
+ * @struct binary_tree_s
+ * @brief A structure to represent a node in a weak AVL tree.
+ *
+ * This structure holds the value of the node, its rank and pointers to the left and right child nodes.
+ */
+typedef struct binary_tree {
+  int value;                         /**< The value of the node */
+  int rank;                          /**< The rank of the node, 0 for a leaf */
+  struct binary_tree *left;          /**< Pointer to the left child */
+  struct binary_tree *right;         /**< Pointer to the right child */
+} binary_tree_s;
+
+/**
+ * @brief Returns the rank of a tree.
+ *
+ * @param tree The root of the binary tree.
+ * @return The rank of the root, -1 if the tree is empty.
+ */
+static int rank(binary_tree_s *tree) {
+  return (tree == NULL) ? -1 : tree->rank;
+}
+
+/**
+ * @brief Calculates the height of the binary tree.
+ *
+ * This function determines the height of the binary tree recursively. The height of a tree is the number of edges
+ * along the longest path from the root down to the farthest leaf node.
+ *
+ * @param tree The root of the binary tree.
+ * @return The height of the tree. Returns -1 if the tree is empty.
+ */
+static int wavl_binary_tree_height(binary_tree_s *tree) {
+  if(tree==NULL)
+    return -1;
+  else {
+    int left  = wavl_binary_tree_height(tree->left);
+    int right = wavl_binary_tree_height(tree->right);
+    int max = (left > right) ? left : right;
+    return max + 1;
+  }
+}
+
+/**
+ * @brief Counts the total number of nodes in the binary tree.
+ *
+ * This function recursively calculates the total number of nodes in the binary tree.
+ *
+ * @param tree The root of the binary tree.
+ * @return The total number of nodes in the tree. Returns 0 if the tree is empty.
+ */
+static int wavl_binary_tree_nodes(binary_tree_s *tree) {
+  if(tree==NULL)
+    return 0;
+  else
+    return wavl_binary_tree_nodes(tree->left) + wavl_binary_tree_nodes(tree->right) + 1;
+}
+
+/**
+ * @brief Internal helper function to print the binary tree.
+ *
+ * This recursive function assists in printing the binary tree in a structured ASCII art format.
+ * The function utilizes depth to determine the prefixes and branching structure for each node.
+ *
+ * @param node The current node being printed.
+ * @param depth The current depth in the tree.
+ * @param height The height of the tree.
+ * @param is_left Flag indicating if the current node is a left child.
+ * @param prefix The current prefix for aligning the printed output.
+ */
+static void binary_tree_print_aux(binary_tree_s *node, int depth, int height, int is_left, char *prefix) {
+  char new_prefix[200]; // Buffer limited to 200 bytes (<200 characters)
+  if (node == NULL) return;
+  // print right
+  if (node->right != NULL) {
+    char *s1 = (is_left) ? "│" : " ";
+    char *s2 = (is_left) ? " " : "│";
+    snprintf(new_prefix, sizeof(new_prefix), "%s%s          ", prefix, s1);
+    binary_tree_print_aux(node->right, depth + 1, height, 0, new_prefix);
+    snprintf(new_prefix, sizeof(new_prefix), "%s%s          ", prefix, s2);
+  }
+  // print node
+  printf("%s", prefix);
+  char *s1 = (depth) ? ((is_left) ? "└" : "┌") : " ";
+  char *s2 = (depth >= height) ? " " : ((node->left) ? ((node->right) ? "┤" : "┐") : ((node->right) ? "┘" : " "));
+  printf("%s(%04d)[%02d]%s\n", s1, node->value, node->rank, s2);
+  // print left
+  if (node->left != NULL) {
+    char *s1 = (depth) ? ((is_left) ? " " : "│") : " ";
+    char *s2 = (depth) ? ((is_left) ? "│" : " ") : " ";
+    snprintf(new_prefix, sizeof(new_prefix), "%s%s          ", prefix, s1);
+    binary_tree_print_aux(node->left, depth + 1, height, 1, new_prefix);
+    snprintf(new_prefix, sizeof(new_prefix), "%s%s          ", prefix, s2);
+  }
+  return;
+}
+
+/**
+ * @brief Public function to print the entire binary tree.
+ *
+ * This function prints the binary tree starting from the root. It displays the tree's height and number of nodes
+ * before printing the tree structure.
+ *
+ * @param tree The root of the binary tree to be printed.
+ */
+static void wavl_binary_tree_print(binary_tree_s *tree) {
+  int height = wavl_binary_tree_height(tree);
+  int nodes = wavl_binary_tree_nodes(tree);
+  printf("height : %d  - nodes : %d\n", height, nodes);
+  if (height>=0)
+    binary_tree_print_aux(tree, 0, height, 0, "");
+  else
+    printf("Empty binary tree.\n");
+  return;
+}
+
+/**
+ * @brief Find the node with the minimum value in a binary search tree.
+ *
+ * This helper function is used to find the in-order successor, i.e., the smallest node
+ * in the given binary tree rooted at the specified node.
+ *
+ * @param node The root node of the subtree.
+ * @return the minimum value in the given subtree.
+ */
+static int wavl_min_value_node(binary_tree_s *node) {
+  assert(node != NULL);
+  BST_COUNT(visits);
+  while(node->left!=NULL) {
+    node = node->left;
+    BST_COUNT(visits);
+  }
+  return node->value;
+}
+
+/**
+ * @brief Performs a left rotation on the binary tree at the root.
+ *
+ * This rotation is performed by making the right child of the root the new root of the subtree,
+ * and making the original root the left child of the new root. The ranks are left unchanged and
+ * are updated by the caller.
+ *
+ * @param tree The root of the binary tree to rotate.
+ * @return The new root of the subtree after rotation.
+ */
+static binary_tree_s *bst_rotate_left(binary_tree_s *tree) {
+  if (tree == NULL || tree->right == NULL) {
+    return tree;  // No rotation needed if tree is NULL or has no right child
+  }
+  BST_COUNT(rotations);
+  binary_tree_s *new_root = tree->right;
+  tree->right = new_root->left;
+  new_root->left = tree;
+  return new_root;
+}
+
+/**
+ * @brief Performs a right rotation on the binary tree at the root.
+ *
+ * This rotation is performed by making the left child of the root the new root of the subtree,
+ * and making the original root the right child of the new root. The ranks are left unchanged and
+ * are updated by the caller.
+ *
+ * @param tree The root of the binary tree to rotate.
+ * @return The new root of the subtree after rotation.
+ */
+static binary_tree_s *bst_rotate_right(binary_tree_s *tree) {
+  if (tree == NULL || tree->left == NULL) {
+    return tree;  // No rotation needed if tree is NULL or has no left child
+  }
+  BST_COUNT(rotations);
+  binary_tree_s *new_root = tree->left;
+  tree->left = new_root->right;
+  new_root->right = tree;
+  return new_root;
+}
+
+/**
+ * @brief Restores the rank rule at a node after an insertion in one of its subtrees.
+ *
+ * An insertion can only create a 0-child, i.e. a child having the same rank as the node :
+ * - if the other child is a 1-child, the node is promoted and the problem may move up;
+ * - otherwise the other child is a 2-child, and a single or a double rotation ends the rebalancing.
+ *
+ * @param tree The node whose subtree received the new value.
+ * @return The root of the subtree after the rebalancing.
+ */
+static binary_tree_s *fix_insert(binary_tree_s *tree) {
+  if (rank(tree->left) == tree->rank) {
+    binary_tree_s *child = tree->left;
+    if (tree->rank - rank(tree->right) == 1) {
+      tree->rank++; // promote
+      return tree;
+    }
+    if (child->rank - rank(child->left) == 1) {
+      // Left Left Case: single rotation
+      tree->rank--;
+      return bst_rotate_right(tree);
+    }
+    // Left Right Case: double rotation
+    child->right->rank++;
+    child->rank--;
+    tree->rank--;
+    tree->left = bst_rotate_left(child);
+    return bst_rotate_right(tree);
+  }
+  if (rank(tree->right) == tree->rank) {
+    binary_tree_s *child = tree->right;
+    if (tree->rank - rank(tree->left) == 1) {
+      tree->rank++; // promote
+      return tree;
+    }
+    if (child->rank - rank(child->right) == 1) {
+      // Right Right Case: single rotation
+      tree->rank--;
+      return bst_rotate_left(tree);
+    }
+    // Right Left Case: double rotation
+    child->left->rank++;
+    child->rank--;
+    tree->rank--;
+    tree->right = bst_rotate_right(child);
+    return bst_rotate_left(tree);
+  }
+  return tree;
+}
+
+/**
+ * @brief Adds a node to the binary tree and rebalances it with the weak AVL rank rules.
+ *
+ * The value is inserted as a new leaf of rank 0, then `fix_insert` is applied on the way back up
+ * to the root. If the value already exists in the tree, the tree is returned unchanged.
+ *
+ * @param value The value to be added to the tree.
+ * @param tree The root of the binary tree (can be NULL if the tree is empty).
+ * @return The new or modified root of the tree after insertion and possible rotation.
+ */
+static binary_tree_s *wavl_add_node(int value, binary_tree_s *tree) {
+  if (tree == NULL) {
+    tree = malloc(sizeof(binary_tree_s));
+    assert(tree != NULL);
+    BST_COUNT(allocations);
+    tree->value = value;
+    tree->rank = 0;
+    tree->left = tree->right = NULL;
+    return tree;
+  }
+  BST_COUNT(visits);
+  if (BST_COMPARE(value < tree->value)) {
+    tree->left = wavl_add_node(value, tree->left);
+  } else if (BST_COMPARE(value > tree->value)) {
+    tree->right = wavl_add_node(value, tree->right);
+  } else {
+    return tree;
+  }
+  return fix_insert(tree);
+}
+
+/**
+ * @brief Restores the rank rule at a node after a removal in one of its subtrees.
+ *
+ * A removal can leave a leaf of rank 1 (a 2,2 leaf), which is demoted, or create a 3-child.
+ * Let the sibling be the other child of the node :
+ * - if the sibling is a 2-child, the node is demoted and the problem may move up;
+ * - if the sibling is a 1-child whose children are both 2-children, the node and the sibling are demoted;
+ * - otherwise a single or a double rotation ends the rebalancing.
+ *
+ * @param tree The node whose subtree lost a value.
+ * @return The root of the subtree after the rebalancing.
+ */
+static binary_tree_s *fix_remove(binary_tree_s *tree) {
+  if (tree->left == NULL && tree->right == NULL) {
+    tree->rank = 0; // demote a 2,2 leaf
+    return tree;
+  }
+  if (tree->rank - rank(tree->left) == 3) {
+    binary_tree_s *sibling = tree->right;
+    if (tree->rank - sibling->rank == 2) {
+      tree->rank--;
+      return tree;
+    }
+    int inner = sibling->rank - rank(sibling->left);
+    int outer = sibling->rank - rank(sibling->right);
+    if (inner == 2 && outer == 2) {
+      tree->rank--;
+      sibling->rank--;
+      return tree;
+    }
+    if (outer == 1) {
+      // Right Right Case: single rotation
+      sibling->rank++;
+      tree->rank--;
+      if (tree->left == NULL && sibling->left == NULL)
+        tree->rank--; // tree becomes a leaf
+      return bst_rotate_left(tree);
+    }
+    // Right Left Case: double rotation
+    sibling->left->rank += 2;
+    sibling->rank--;
+    tree->rank -= 2;
+    tree->right = bst_rotate_right(sibling);
+    return bst_rotate_left(tree);
+  }
+  if (tree->rank - rank(tree->right) == 3) {
+    binary_tree_s *sibling = tree->left;
+    if (tree->rank - sibling->rank == 2) {
+      tree->rank--;
+      return tree;
+    }
+    int inner = sibling->rank - rank(sibling->right);
+    int outer = sibling->rank - rank(sibling->left);
+    if (inner == 2 && outer == 2) {
+      tree->rank--;
+      sibling->rank--;
+      return tree;
+    }
+    if (outer == 1) {
+      // Left Left Case: single rotation
+      sibling->rank++;
+      tree->rank--;
+      if (tree->right == NULL && sibling->right == NULL)
+        tree->rank--; // tree becomes a leaf
+      return bst_rotate_right(tree);
+    }
+    // Left Right Case: double rotation
+    sibling->right->rank += 2;
+    sibling->rank--;
+    tree->rank -= 2;
+    tree->left = bst_rotate_left(sibling);
+    return bst_rotate_right(tree);
+  }
+  return tree;
+}
+
+/**
+ * @brief Searches for a node with a specific value in the binary tree.
+ *
+ * This function checks if the tree contains a node with the specified value using a binary search approach.
+ * It returns true if the value is found and false otherwise.
+ *
+ * @param value The value to search for in the tree.
+ * @param tree The root of the binary tree.
+ * @return true if the value is found, false otherwise.
+ */
+static bool wavl_find_node(int value, binary_tree_s *tree) {
+  while (tree != NULL) {
+    BST_COUNT(visits);
+    if (BST_COMPARE(tree->value == value))
+      return true;
+    tree = BST_COMPARE(tree->value < value) ? tree->right : tree->left;
+  }
+  return false;
+}
+
+/**
+ * @brief Prints all values in the binary search tree in a sorted order.
+ *
+ * This function outputs all the values from the binary search tree rooted at the specified node
+ * to the standard output. The values are displayed in ascending order if `ascending` is true,
+ * and in descending order if `ascending` is false. This is useful for debugging or visual verification
+ * of tree contents.
+ *
+ * @param tree The root node of the binary tree to be dumped.
+ * @param ascending Specifies the order of the output: true for ascending, false for descending.
+ */
+static void wavl_dump_tree(binary_tree_s *tree, bool ascending) {
+  if(tree != NULL){
+    if(ascending){
+      wavl_dump_tree(tree->left,ascending);
+      printf("%d ",tree->value);
+      wavl_dump_tree(tree->right,ascending);
+    } else {
+      wavl_dump_tree(tree->right,ascending);
+      printf("%d ",tree->value);
+      wavl_dump_tree(tree->left,ascending);
+    }
+  }
+  return;
+}
+
+/**
+ * @brief Copies all values of the binary search tree in ascending order into an array.
+ *
+ * @param tree The root node of the binary tree.
+ * @param array The array receiving the values, large enough for all the values of the tree.
+ * @return The number of values copied.
+ */
+static int wavl_binary_tree_to_array(binary_tree_s *tree, int *array) {
+  if(tree==NULL)
+    return 0;
+  int n = wavl_binary_tree_to_array(tree->left, array);
+  array[n++] = tree->value;
+  return n + wavl_binary_tree_to_array(tree->right, array + n);
+}
+
+/**
+ * @brief Removes a node with a specified value from the binary tree and rebalances the tree.
+ *
+ * The node is removed as in a naive binary search tree : a node with two children takes the value of
+ * its in-order successor, which is removed instead. Then `fix_remove` is applied on the way back up
+ * to the root.
+ *
+ * @param value The value of the node to be removed.
+ * @param tree The root of the binary tree.
+ * @return The new or modified root of the tree after the removal and possible rebalancing.
+ */
+static binary_tree_s *wavl_remove_node(int value, binary_tree_s *tree) {
+  if (tree == NULL) {
+    return NULL; // Value not found
+  }
+  BST_COUNT(visits);
+  if (BST_COMPARE(value < tree->value)) {
+    tree->left = wavl_remove_node(value, tree->left);
+  } else if (BST_COMPARE(value > tree->value)) {
+    tree->right = wavl_remove_node(value, tree->right);
+  } else if (tree->left == NULL || tree->right == NULL) {
+    // Node with only one child or no child
+    binary_tree_s *child = (tree->left != NULL) ? tree->left : tree->right;
+    free(tree);
+    return child;
+  } else {
+    // Node with two children: Get the inorder successor
+    tree->value = wavl_min_value_node(tree->right);
+    tree->right = wavl_remove_node(tree->value, tree->right);
+  }
+  return fix_remove(tree);
+}
+
+/**
+ * @brief Frees the memory occupied by a binary tree.
+ *
+ * This function recursively frees all nodes of a binary tree, starting from the leaves
+ * towards the root. It safely handles trees that are NULL by terminating early.
+ *
+ * @param tree Pointer to the root of the binary tree to be freed.
+ */
+static void wavl_binary_tree_free(binary_tree_s *tree) {
+  if(tree==NULL)
+    return;
+  wavl_binary_tree_free(tree->left);
+  wavl_binary_tree_free(tree->right);
+  free(tree);
+}
+
+/**
+ * @brief Operations of the weak AVL tree engine.
+ */
+const bst_ops_t wavl_bst_ops = {
+  .name = "wavl",
+  .add_node = wavl_add_node,
+  .find_node = wavl_find_node,
+  .remove_node = wavl_remove_node,
+  .binary_tree_height = wavl_binary_tree_height,
+  .binary_tree_nodes = wavl_binary_tree_nodes,
+  .min_value_node = wavl_min_value_node,
+  .dump_tree = wavl_dump_tree,
+  .binary_tree_to_array = wavl_binary_tree_to_array,
+  .binary_tree_print = wavl_binary_tree_print,
+  .binary_tree_free = wavl_binary_tree_free,
+  .stats = true,
+};
@@ -0,0 +1,93 @@
+#!/bin/sh
+# workload.sh - runs a representative workload through every bst engine, the heap, heapsort, topk and
+# the priority queue, and prints the time spent by each program.
+#
+# usage: ./workload.sh SEED BIN_DIR PREFIX...
+#
+# For each PREFIX ("" for the release programs, "test_" for the debug-sanitized ones, "pgo_" for the
+# PGO ones), the programs BIN_DIR/PREFIXbst, PREFIXheap, PREFIXheapsort, PREFIXtopk and
+# PREFIXpriority_queue run the workload drawn from SEED. A table gives the time in milliseconds of each
+# program per prefix, then the total and the speedup of each prefix over the first one.
+
+if [ $# -lt 3 ]; then
+  echo "usage: $0 SEED BIN_DIR PREFIX..." >&2
+  exit 1
+fi
+SEED=$1
+BIN=$2
+shift 2
+
+ENGINES="simple avl rb treap scapegoat wavl skiplist radix adaptive bucket roaring"
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+# bst: 20000 random additions, 10000 finds, 10000 removals and a compression
+awk -v seed="$SEED" 'BEGIN { srand(seed);
+  for (i = 0; i < 20000; i++) printf "%d ", int(rand() * 100000);
+  for (i = 0; i < 10000; i++) printf "f %d ", int(rand() * 100000);
+  for (i = 0; i < 10000; i++) printf "r %d ", int(rand() * 100000);
+  printf "c\n" }' > "$WORK/bst"
+# heap and priority queue: 10^6 distinct additions interleaved with peeks, then 10^6 removals, read
+# from the standard input. The values follow the Lehmer generator x * 48271 mod (2^31 - 1), whose
+# period is 2^31 - 2, so they do not repeat, and are spread enough for the simple bst of the queue.
+awk -v seed="$SEED" 'BEGIN { x = seed;
+  for (i = 0; i < 1000000; i++) { x = (x * 48271) % 2147483647; printf "%d p\n", x }
+  for (i = 0; i < 1000000; i++) printf "r\n" }' > "$WORK/queue"
+# heapsort: 10^6 values read from the standard input
+awk -v seed="$SEED" 'BEGIN { srand(seed);
+  for (i = 0; i < 1000000; i++) printf "%d\n", int(rand() * 2000000) - 1000000 }' > "$WORK/sort"
+# topk: the 100 largest of 200000 values read from a file
+awk -v seed="$SEED" 'BEGIN { srand(seed);
+  for (i = 0; i < 200000; i++) printf "%d\n", int(rand() * 2000000) - 1000000 }' > "$WORK/stream"
+echo "--k=100 $WORK/stream" > "$WORK/topk"
+
+# run PROGRAM INPUT [OPTION]: runs a program on a workload, prints its time in milliseconds
+run() {
+  start=$(date +%s%N)
+  "$1" $3 $(cat "$2") > /dev/null || echo "$1 failed" >&2
+  end=$(date +%s%N)
+  echo $(( (end - start) / 1000000 ))
+}
+
+# run_stdin PROGRAM INPUT: runs a program on a workload given as its standard input with "-", prints
+# its time in milliseconds
+run_stdin() {
+  start=$(date +%s%N)
+  "$1" - < "$2" > /dev/null || echo "$1 failed" >&2
+  end=$(date +%s%N)
+  echo $(( (end - start) / 1000000 ))
+}
+
+printf "%-22s" "program"
+for prefix in "$@"; do
+  printf "%12s" "${prefix:-release}"
+done
+printf "\n"
+for program in $(for e in $ENGINES; do echo "bst:$e"; done) heap heapsort topk priority_queue; do
+  printf "%-22s" "$program"
+  for prefix in "$@"; do
+    case $program in
+      bst:*) ms=$(run "$BIN/${prefix}bst" "$WORK/bst" "--engine=${program#bst:}") ;;
+      heap|priority_queue) ms=$(run_stdin "$BIN/${prefix}$program" "$WORK/queue") ;;
+      heapsort) ms=$(run_stdin "$BIN/${prefix}$program" "$WORK/sort") ;;
+      topk) ms=$(run "$BIN/${prefix}$program" "$WORK/topk") ;;
+    esac
+    printf "%12d" "$ms"
+    echo "${prefix:-release} $ms" >> "$WORK/times"
+  done
+  printf "\n"
+done
+# total PREFIX: total time of the programs of a prefix
+total() {
+  awk -v p="${1:-release}" '$1 == p { t += $2 } END { print t }' "$WORK/times"
+}
+printf "%-22s" "total"
+for prefix in "$@"; do
+  printf "%12d" "$(total "$prefix")"
+done
+printf "\n%-22s" "speedup"
+base=$(total "$1")
+for prefix in "$@"; do
+  printf "%12s" "$(awk -v b="$base" -v t="$(total "$prefix")" 'BEGIN { printf "%.2f", (t > 0) ? b / t : 0 }')"
+done
+printf "\n"